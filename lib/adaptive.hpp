@@ -0,0 +1,68 @@
+// Copyright © 2025 Giorgio Audrito. All Rights Reserved.
+
+/**
+ * @file adaptive.hpp
+ * @brief Adaptive round frequency, driven by the local stability of values.
+ *
+ * The interval between rounds of a device doubles at every round in which its values are
+ * unchanged, up to a bound, and snaps back to the base interval as soon as they change.
+ * Real-time bounds as T(I) in lib/examples.hpp then hold with Dt the bound on intervals,
+ * after the time needed for the change to reach the device.
+ */
+
+#ifndef FCPP_ADAPTIVE_H_
+#define FCPP_ADAPTIVE_H_
+
+#include <algorithm>
+#include <cmath>
+
+#include "lib/examples.hpp"
+
+
+/**
+ * @brief Namespace containing all the objects in the FCPP library.
+ */
+namespace fcpp {
+
+
+//! @brief Namespace containing the libraries of coordination routines.
+namespace coordination {
+
+
+//! @brief Whether a value is the same as in the previous round (false in the first round).
+template <typename node_t, typename T>
+bool unchanged(ARGS, T const& v) { CODE
+    bool same = old(CALL, v) == v;
+    return same and node.previous_time() >= 0;
+}
+//! @brief Export list for function unchanged.
+template <typename T> FUN_EXPORT unchanged_t = export_list<T>;
+
+
+//! @brief Whether a real value is within a relative tolerance of its value in the previous round (false in the first round).
+FUN bool steady(ARGS, real_t v, real_t tolerance) { CODE
+    real_t p = old(CALL, v);
+    bool close = p == v or std::abs(p - v) <= tolerance * std::abs(v);
+    return close and node.previous_time() >= 0;
+}
+//! @brief Export list for function steady.
+FUN_EXPORT steady_t = export_list<real_t>;
+
+
+//! @brief Computes the next interval between rounds, doubling it while stable (up to `top`) and resetting it to `base` otherwise.
+FUN times_t adaptive_interval(ARGS, bool stable, times_t base, times_t top) { CODE
+    return old(CALL, base, [&](times_t i){
+        return stable ? std::min(2*i, top) : base;
+    });
+}
+//! @brief Export list for function adaptive_interval.
+FUN_EXPORT adaptive_interval_t = export_list<times_t>;
+
+
+} // namespace coordination
+
+
+} // namespace fcpp
+
+
+#endif // FCPP_ADAPTIVE_H_
@@ -0,0 +1,112 @@
+// Copyright © 2025 Giorgio Audrito. All Rights Reserved.
+
+/**
+ * @file aggregators.hpp
+ * @brief Additional aggregators for logging, supporting incremental updates.
+ *
+ * Aggregators can receive the old value of a node through `erase` and the new one through `insert`,
+ * so that loggers pushing values from node rounds pay in proportion to the number of changes.
+ * Loggers scanning all nodes at every log (as in the case study) only insert values.
+ */
+
+#ifndef FCPP_AGGREGATORS_H_
+#define FCPP_AGGREGATORS_H_
+
+#include <cmath>
+#include <limits>
+#include <string>
+
+//! Importing the FCPP library.
+#include "lib/fcpp.hpp"
+
+
+/**
+ * @brief Namespace containing all the objects in the FCPP library.
+ */
+namespace fcpp {
+
+
+//! @brief Namespace for all aggregators.
+namespace aggregator {
+
+
+/**
+ * @brief Mean of values, with compensated summation.
+ *
+ * Insertions and retractions accumulate rounding errors in a plain running sum over a long
+ * simulation; the Kahan-Babuska correction keeps the mean accurate regardless.
+ */
+template <typename T, bool only_finite = std::numeric_limits<T>::has_infinity>
+class kahan_mean {
+  public:
+    //! @brief The type of values aggregated.
+    using type = T;
+
+    //! @brief The type of the aggregation result.
+    template <typename U>
+    using result_type = common::tagged_tuple_t<kahan_mean<U>, T>;
+
+    //! @brief Default constructor.
+    kahan_mean() = default;
+
+    //! @brief Combines aggregated values.
+    kahan_mean& operator+=(kahan_mean const& o) {
+        add(o.m_sum);
+        add(o.m_err);
+        m_count += o.m_count;
+        return *this;
+    }
+
+    //! @brief Erases a value from the aggregation set.
+    void erase(T value) {
+        if (not only_finite or std::isfinite(value)) {
+            add(-value);
+            --m_count;
+        }
+    }
+
+    //! @brief Inserts a new value to be aggregated.
+    void insert(T value) {
+        if (not only_finite or std::isfinite(value)) {
+            add(value);
+            ++m_count;
+        }
+    }
+
+    //! @brief The results of aggregation.
+    template <typename U>
+    result_type<U> result() const {
+        return {m_count == 0 ? std::numeric_limits<T>::quiet_NaN() : (m_sum + m_err) / m_count};
+    }
+
+    //! @brief Prints the aggregator header.
+    template <typename U>
+    static std::string header() {
+        return "mean(" + details::strip_namespaces(common::type_name<U>()) + ")";
+    }
+
+  private:
+    //! @brief Adds a value to the sum, keeping track of the rounding error.
+    void add(T value) {
+        T s = m_sum + value;
+        if (std::abs(m_sum) >= std::abs(value)) m_err += (m_sum - s) + value;
+        else m_err += (value - s) + m_sum;
+        m_sum = s;
+    }
+
+    //! @brief The sum of values.
+    T m_sum = 0;
+    //! @brief The accumulated rounding error of the sum.
+    T m_err = 0;
+    //! @brief The number of values.
+    size_t m_count = 0;
+};
+
+
+} // namespace aggregator
+
+
+} // namespace fcpp
+
+
+#endif // FCPP_AGGREGATORS_H_
@@ -0,0 +1,125 @@
+// Copyright © 2025 Giorgio Audrito. All Rights Reserved.
+
+/**
+ * @file bounded.hpp
+ * @brief Bounded-degree variants of the case study functions.
+ *
+ * Each device only listens to its k nearest neighbours within communication range, selected
+ * once per round by `nearest` and passed to the functions as a mask. Messages are still received
+ * from all neighbours, but the gossip dictionaries merged per round are bounded by k.
+ */
+
+#ifndef FCPP_BOUNDED_H_
+#define FCPP_BOUNDED_H_
+
+#include <algorithm>
+#include <vector>
+
+#include "lib/examples.hpp"
+
+
+/**
+ * @brief Namespace containing all the objects in the FCPP library.
+ */
+namespace fcpp {
+
+
+//! @brief Namespace containing the libraries of coordination routines.
+namespace coordination {
+
+
+//! @brief Selects the current device together with its k nearest neighbours (ties included).
+FUN field<bool> nearest(ARGS, size_t k) { CODE
+    field<real_t> d = node.nbr_dist();
+    // distances of the devices in the domain (skipping the default value at index 0),
+    // including the device itself at distance zero: the k+1 smallest are kept
+    auto const& w = details::get_vals(d);
+    std::vector<real_t> v(w.begin() + 1, w.end());
+    if (v.size() <= k+1) return true;
+    std::nth_element(v.begin(), v.begin() + k, v.end());
+    real_t r = v[k];
+    return map_hood([r](real_t x){
+        return x <= r;
+    }, d);
+}
+
+
+//! @brief Folds the values of the neighbours selected by a mask into an accumulator x, through op(x, value), without copying them.
+template <typename O, typename T, typename R>
+R fold_hood_if(O&& op, field<bool> const& m, field<T> const& f, R x) {
+    std::vector<device_t> const& mi = details::get_ids(m);
+    std::vector<device_t> const& fi = details::get_ids(f);
+    auto const& mv = details::get_vals(m);
+    auto const& fv = details::get_vals(f);
+    // both id lists are sorted, hence they are scanned together
+    for (size_t i = 0, j = 0; i < fi.size(); ++i) {
+        while (j < mi.size() and mi[j] < fi[i]) ++j;
+        if (j < mi.size() and mi[j] == fi[i] ? mv[j+1] : mv[0]) x = op(std::move(x), fv[i+1]);
+    }
+    return x;
+}
+
+
+//! @brief Computes distances from the closest source device, through the neighbours selected by m only.
+FUN real_t bounded_rdist(ARGS, bool source, field<bool> const& m) { CODE
+    return nbr(CALL, stable_t(INF), [&](field<stable_t> d){
+        return stable_t(mux(source, real_t(0), min_hood(CALL, mux(m, d + node.nbr_dist(), INF), INF)));
+    });
+}
+//! @brief Export list for function bounded_rdist.
+FUN_EXPORT bounded_rdist_t = export_list<stable_t>;
+
+
+//! @brief Computes the maximum value of v through timestamped gossiping with the neighbours selected by m only.
+FUN real_t bounded_maximize(ARGS, real_t v, times_t threshold, field<bool> const& m) { CODE
+    time_dict loc = {{node.uid, {node.current_time(),v}}};
+    time_dict glob = nbr(CALL, loc, [&](field<time_dict> n){
+        time_dict x = update(fold_hood_if(update, m, n, time_dict{}), loc);
+        return discard(x, node.current_time() - threshold);
+    });
+    return max_value(glob);
+}
+//! @brief Export list for function bounded_maximize.
+FUN_EXPORT bounded_maximize_t = export_list<time_dict>;
+
+
+//! @brief Computes hop-count distances from the closest source device, through the neighbours selected by m only.
+FUN hops_t bounded_dist(ARGS, bool source, field<bool> const& m) { CODE
+    return nbr(CALL, HOPS_MAX, [&](field<hops_t> d){
+        return (hops_t)mux(source, 0, min_hood(CALL, mux(m, d, HOPS_MAX), HOPS_MAX) + 1);
+    });
+}
+//! @brief Export list for function bounded_dist.
+FUN_EXPORT bounded_dist_t = export_list<hops_t>;
+
+
+//! @brief Calculates the diameter of a network, as in hop_diameter, through the neighbours selected by m only.
+FUN diam_data bounded_hop_diameter(ARGS, times_t threshold, field<bool> const& m) { CODE
+    bool source = election(CALL);
+    hops_t d = bounded_dist(CALL, source, m);
+    real_t diam = bounded_maximize(CALL, d, threshold, m);
+    return diam_data(source, d, diam);
+}
+//! @brief Export list for function bounded_hop_diameter.
+FUN_EXPORT bounded_hop_diameter_t = export_list<election_t, bounded_dist_t, bounded_maximize_t>;
+
+
+//! @brief Stabilised calculation of the diameter of a network, as in stable_diameter, through the neighbours selected by m only.
+FUN diam_data bounded_stable_diameter(ARGS, bool source, field<bool> const& m) { CODE
+    real_t d = bounded_rdist(CALL, source, m);
+    real_t z = d == INF ? 0 : d;
+    real_t avgd = integrate(CALL, z) / integrate(CALL, 1);
+    real_t diam = maxgossip(CALL, lowpass(CALL, avgd));
+    return diam_data(source, avgd, diam);
+}
+//! @brief Export list for function bounded_stable_diameter.
+FUN_EXPORT bounded_stable_diameter_t = export_list<bounded_rdist_t, integrate_t, lowpass_t, maxgossip_t>;
+
+
+} // namespace coordination
+
+
+} // namespace fcpp
+
+
+#endif // FCPP_BOUNDED_H_
@@ -0,0 +1,175 @@
+// Copyright © 2025 Giorgio Audrito. All Rights Reserved.
+
+/**
+ * @file capture.hpp
+ * @brief Offscreen software rendering of simulation frames to image files.
+ *
+ * Frames are rasterised and encoded on a background thread, so that capturing them
+ * does not slow down the simulation, and no display server nor OpenGL is needed.
+ */
+
+#ifndef FCPP_CAPTURE_H_
+#define FCPP_CAPTURE_H_
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+//! Importing the FCPP library.
+#include "lib/fcpp.hpp"
+
+
+/**
+ * @brief Namespace containing all the objects in the FCPP library.
+ */
+namespace fcpp {
+
+
+//! @brief An RGB pixel.
+using pixel = std::array<uint8_t, 3>;
+
+//! @brief Converts a color into an RGB pixel.
+inline pixel to_pixel(color const& c) {
+    auto byte = [](real_t x){
+        return uint8_t(std::lround(std::clamp<real_t>(x, 0, 1) * 255));
+    };
+    return {byte(c.red()), byte(c.green()), byte(c.blue())};
+}
+
+//! @brief A node to be drawn, as a disc of the outer color with a core of the inner color.
+struct dot {
+    //! @brief Position of the node.
+    real_t x, y;
+    //! @brief Radius of the node (in units of the space).
+    real_t radius;
+    //! @brief Inner color band.
+    pixel in;
+    //! @brief Outer color band.
+    pixel out;
+};
+
+//! @brief A frame to be drawn.
+struct frame {
+    //! @brief Simulated time of the frame.
+    times_t time;
+    //! @brief The nodes in the frame.
+    std::vector<dot> dots;
+};
+
+
+/**
+ * @brief Writes frames as numbered binary PPM images, from a background thread.
+ *
+ * A square area of the space with side `side` is mapped onto a `width` x `width` image.
+ */
+class frame_writer {
+  public:
+    //! @brief Constructor, given the prefix of image files (whose directory is created if needed).
+    frame_writer(std::string prefix, size_t width, real_t side) :
+        m_prefix(std::move(prefix)),
+        m_width(width),
+        m_scale(width / side),
+        m_thread(&frame_writer::work, this) {
+        std::filesystem::path dir = std::filesystem::path(m_prefix).parent_path();
+        if (not dir.empty()) std::filesystem::create_directories(dir);
+    }
+
+    //! @brief Destructor, waiting for all pending frames to be written.
+    ~frame_writer() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_done = true;
+        }
+        m_cv.notify_one();
+        m_thread.join();
+    }
+
+    //! @brief Queues a frame for writing.
+    void push(frame f) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_queue.push_back(std::move(f));
+        }
+        m_cv.notify_one();
+    }
+
+    //! @brief Number of frames written so far.
+    size_t count() const {
+        return m_count;
+    }
+
+  private:
+    //! @brief Background loop, writing frames as they come.
+    void work() {
+        std::vector<pixel> image(m_width * m_width);
+        while (true) {
+            frame f;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_cv.wait(lock, [this](){ return m_done or m_queue.size(); });
+                if (m_queue.empty()) return;
+                f = std::move(m_queue.front());
+                m_queue.pop_front();
+            }
+            std::fill(image.begin(), image.end(), pixel{255, 255, 255});
+            for (dot const& d : f.dots) {
+                draw(image, d, d.radius, d.out);
+                draw(image, d, d.radius / 2, d.in);
+            }
+            char num[16];
+            std::snprintf(num, sizeof(num), "%05zu", m_count.load());
+            std::ofstream os(m_prefix + num + ".ppm", std::ios::binary);
+            os << "P6\n" << m_width << " " << m_width << "\n255\n";
+            os.write(reinterpret_cast<char const*>(image.data()), image.size() * sizeof(pixel));
+            ++m_count;
+        }
+    }
+
+    //! @brief Draws a disc of a given radius and color centered on a node (with y pointing up).
+    void draw(std::vector<pixel>& image, dot const& d, real_t radius, pixel c) const {
+        real_t cx = d.x * m_scale, cy = m_width - d.y * m_scale, r = std::max<real_t>(radius * m_scale, 0.5);
+        intmax_t w = m_width;
+        intmax_t x0 = std::max<intmax_t>(std::floor(cx - r), 0), x1 = std::min<intmax_t>(std::ceil(cx + r), w - 1);
+        intmax_t y0 = std::max<intmax_t>(std::floor(cy - r), 0), y1 = std::min<intmax_t>(std::ceil(cy + r), w - 1);
+        for (intmax_t y = y0; y <= y1; ++y)
+            for (intmax_t x = x0; x <= x1; ++x)
+                if ((x + 0.5 - cx) * (x + 0.5 - cx) + (y + 0.5 - cy) * (y + 0.5 - cy) <= r * r)
+                    image[y * w + x] = c;
+    }
+
+    //! @brief Prefix of image files.
+    std::string const m_prefix;
+    //! @brief Width (and height) of images.
+    size_t const m_width;
+    //! @brief Pixels per unit of space.
+    real_t const m_scale;
+    //! @brief Frames waiting to be written.
+    std::deque<frame> m_queue;
+    //! @brief Number of frames written.
+    std::atomic<size_t> m_count{0};
+    //! @brief Whether no more frames will be pushed.
+    bool m_done = false;
+    //! @brief Mutex guarding the queue.
+    std::mutex m_mutex;
+    //! @brief Condition variable signalling new frames.
+    std::condition_variable m_cv;
+    //! @brief The background thread (started last).
+    std::thread m_thread;
+};
+
+
+} // namespace fcpp
+
+
+#endif // FCPP_CAPTURE_H_
@@ -0,0 +1,597 @@
+// Copyright © 2025 Giorgio Audrito. All Rights Reserved.
+
+/**
+ * @file case_study.hpp
+ * @brief Simulation setup for the case study of Section 7, shared by all executables.
+ *
+ * Headless executables should define FCPP_CASE_STUDY_RENDER as 0 before including this file,
+ * dropping the storage tags and computations that are only needed for rendering.
+ * Executables reading the scenario parameters at run time (instead of using the constants below)
+ * should define FCPP_CASE_STUDY_RUNTIME as 1, and give them as the `scenario` network parameter.
+ * Executables forking running networks should define FCPP_CASE_STUDY_PARALLEL as 0, so that rounds
+ * run sequentially and no lock can be held by another thread at the time of a fork.
+ * Networks with adaptive rounds (the `adaptive` network parameter set to true) should use `option::adaptive_list`
+ * instead of `option::list`, retaining messages long enough for neighbours waiting between stretched rounds.
+ * If FCPP_MEMORY is defined, the memory used per node is accounted and plotted.
+ * If FCPP_METRICS is defined, rounds, messages and changes are counted for a metrics sink.
+ * If FCPP_COMPRESSION is defined, the values computed by every round are also sent compressed.
+ */
+
+#ifndef FCPP_CASE_STUDY_H_
+#define FCPP_CASE_STUDY_H_
+
+#include "lib/adaptive.hpp"
+#include "lib/aggregators.hpp"
+#include "lib/bounded.hpp"
+#include "lib/compression.hpp"
+#include "lib/examples.hpp"
+#include "lib/metrics.hpp"
+#include "lib/runtime.hpp"
+
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+//! @brief Whether node shapes, sizes and colors are computed for rendering.
+#ifndef FCPP_CASE_STUDY_RENDER
+#define FCPP_CASE_STUDY_RENDER 1
+#endif
+
+//! @brief Whether scenario parameters are read at run time.
+#ifndef FCPP_CASE_STUDY_RUNTIME
+#define FCPP_CASE_STUDY_RUNTIME 0
+#endif
+
+//! @brief Whether node rounds are run in parallel.
+#ifndef FCPP_CASE_STUDY_PARALLEL
+#define FCPP_CASE_STUDY_PARALLEL 1
+#endif
+
+/**
+ * @brief Namespace containing all the objects in the FCPP library.
+ */
+namespace fcpp {
+
+//! @brief Number of nodes in the area.
+constexpr int node_num = 500;
+//! @brief Size of the area.
+constexpr size_t size = 1000;
+//! @brief The maximum communication range between nodes.
+constexpr size_t comm_range = 100;
+//! @brief Dimensionality of the space.
+constexpr size_t dim = 2;
+
+//! @brief Factor for calculating hues from real distances.
+constexpr real_t hue_factor = 360.0 / size;
+
+//! @brief Number of sources.
+constexpr size_t source_num = 4;
+//! @brief Convergence time for each source.
+constexpr size_t conv_time = 70;
+//! @brief End of the simulation.
+constexpr size_t end_time = source_num * conv_time + 20;
+//! @brief Time after which old values are discarded.
+constexpr times_t discard_time = size * 1.5 / comm_range;
+//! @brief Mean time between rounds of a node (in tenths of a second).
+constexpr intmax_t round_mean = 10;
+//! @brief Deviation of the time between rounds of a node (in tenths of a second).
+constexpr intmax_t round_dev = 1;
+//! @brief Number of rounds after which the latest message of a neighbour expires.
+constexpr intmax_t retain_rounds = 3;
+
+//! @brief Maximum interval between rounds when adaptive (in mean rounds).
+constexpr intmax_t max_interval = 8;
+//! @brief Relative change of the stabilised diameter below which it is considered stable.
+constexpr real_t stable_tolerance = 1e-3;
+
+//! @brief Whether former sources are kept in the network as dormant nodes (otherwise they are removed).
+constexpr bool dormant_sources = false;
+
+//! @brief Fixed positions of sources.
+constexpr vec<2> source_pos[source_num] = {{size/2,size/2}, {size/4,size*3/4}, {size/2+20,size/2-20}, {size,size}};
+
+//! @brief Maximum number of sources in scenarios given at run time.
+constexpr size_t max_sources = 16;
+
+
+//! @brief Parameters of the scenario, defaulting to the constants above.
+struct parameters {
+    //! @brief Number of nodes in the area.
+    size_t node_num = fcpp::node_num;
+    //! @brief Size of the area.
+    real_t size = fcpp::size;
+    //! @brief The maximum communication range between nodes.
+    real_t comm_range = fcpp::comm_range;
+    //! @brief Number of sources.
+    size_t source_num = fcpp::source_num;
+    //! @brief Convergence time for each source.
+    times_t conv_time = fcpp::conv_time;
+    //! @brief End of the simulation.
+    times_t end_time = fcpp::end_time;
+    //! @brief Time after which old values are discarded.
+    times_t discard_time = fcpp::discard_time;
+    //! @brief Fixed positions of sources.
+    vec<2> source_pos[max_sources] = {fcpp::source_pos[0], fcpp::source_pos[1], fcpp::source_pos[2], fcpp::source_pos[3]};
+
+    //! @brief Factor for calculating hues from real distances.
+    constexpr real_t hue_factor() const {
+        return 360.0 / size;
+    }
+};
+
+
+/**
+ * @brief Reads the parameters of the scenario from the command line.
+ *
+ * Arguments are of the form `name=value` (or `--name=value`), with the names of the members of `parameters`,
+ * or `config=file` reading a file with an argument per line (empty lines and lines starting with `#` are skipped).
+ * Numeric parameters must be positive (and integral for the numbers of nodes and sources), and are rejected otherwise
+ * with an exception, as are malformed or unknown arguments. Source positions are given as `x,y;x,y;...`, one for every
+ * source and within the area. Unless given, the end time and the discard time are derived from
+ * the other parameters as in the constants above, and sources are placed as in the constants above (in the given area).
+ */
+inline parameters read_parameters(int argc, char const* const* argv) {
+    std::map<std::string, std::string> args;
+    auto add = [&](std::string a){
+        if (a.compare(0, 2, "--") == 0) a = a.substr(2);
+        size_t i = a.find('=');
+        if (i == std::string::npos) throw std::invalid_argument("expected name=value, found: " + a);
+        args[a.substr(0, i)] = a.substr(i+1);
+    };
+    for (int i = 1; i < argc; ++i) {
+        std::string a = argv[i];
+        if (a.compare(0, 9, "--config=") == 0 or a.compare(0, 7, "config=") == 0) {
+            std::ifstream f(a.substr(a.find('=') + 1));
+            if (not f) throw std::invalid_argument("cannot read config file: " + a.substr(a.find('=') + 1));
+            for (std::string line; std::getline(f, line);)
+                if (line.size() and line[0] != '#') add(line);
+        } else add(a);
+    }
+    parameters p;
+    auto get = [&](std::string const& name, auto& x){
+        auto it = args.find(name);
+        if (it == args.end()) return false;
+        char* e;
+        real_t v = std::strtod(it->second.c_str(), &e);
+        if (it->second.empty() or *e or not (v > 0 and v < INF)) throw std::invalid_argument(name + " must be a positive number, found: " + it->second);
+        // the maximum of an integral type rounds up as a real, so that it is excluded as well
+        using T = std::decay_t<decltype(x)>;
+        real_t top = std::numeric_limits<T>::max();
+        if (std::is_integral<T>::value ? v >= top : v > top) throw std::invalid_argument(name + " is too large, found: " + it->second);
+        if (std::is_integral<T>::value and v != std::floor(v)) throw std::invalid_argument(name + " must be an integer, found: " + it->second);
+        x = v;
+        args.erase(it);
+        return true;
+    };
+    get("node_num", p.node_num);
+    get("size", p.size);
+    get("comm_range", p.comm_range);
+    get("source_num", p.source_num);
+    get("conv_time", p.conv_time);
+    if (p.source_num < 1 or p.source_num > max_sources) throw std::invalid_argument("source_num must be between 1 and " + std::to_string(max_sources));
+    if (not get("end_time", p.end_time)) p.end_time = p.source_num * p.conv_time + 20;
+    if (not get("discard_time", p.discard_time)) p.discard_time = p.size * 1.5 / p.comm_range;
+    real_t s = p.size / fcpp::size;
+    for (size_t i = 0; i < max_sources; ++i) p.source_pos[i] = fcpp::source_pos[i % fcpp::source_num] * s;
+    auto it = args.find("source_pos");
+    if (it != args.end()) {
+        std::string v = it->second;
+        auto coord = [](std::string const& x){
+            char* e;
+            real_t r = std::strtod(x.c_str(), &e);
+            if (x.empty() or *e or not std::isfinite(r)) throw std::invalid_argument("source_pos must hold finite numbers, found: " + x);
+            return r;
+        };
+        size_t i = 0;
+        for (size_t j = 0; j < v.size(); ++i) {
+            size_t c = v.find(',', j), e = std::min(v.find(';', j), v.size());
+            if (c > e) throw std::invalid_argument("expected x,y in source_pos: " + v.substr(j, e-j));
+            if (i == p.source_num) throw std::invalid_argument("source_pos must hold source_num = " + std::to_string(p.source_num) + " positions, found more: " + v);
+            vec<2> q{coord(v.substr(j, c-j)), coord(v.substr(c+1, e-c-1))};
+            if (q[0] < 0 or q[0] > p.size or q[1] < 0 or q[1] > p.size) throw std::invalid_argument("source_pos must lie within [0,size]x[0,size], found: " + v.substr(j, e-j));
+            p.source_pos[i] = q;
+            j = e + 1;
+        }
+        if (i < p.source_num) throw std::invalid_argument("source_pos must hold source_num = " + std::to_string(p.source_num) + " positions, found " + std::to_string(i) + ": " + v);
+        args.erase(it);
+    }
+    if (args.size()) throw std::invalid_argument("unknown parameter: " + args.begin()->first);
+    return p;
+}
+
+
+#ifdef FCPP_METRICS
+//! @brief Namespace for metrics.
+namespace metrics {
+    //! @brief Number of rounds performed.
+    inline counter rounds{"rounds"};
+    //! @brief Number of messages received.
+    inline counter messages{"messages"};
+    //! @brief Bytes of messages sent.
+    inline counter bytes{"bytes"};
+    //! @brief Number of rounds changing hop-count distances or diameters (none after convergence).
+    inline counter changes{"changes"};
+    //! @brief Wall-clock time spent in rounds (in nanoseconds), whose rate is the average number of busy threads.
+    inline counter round_ns{"round_ns"};
+    //! @brief The latest simulated time.
+    inline gauge simulated_time{"simulated_time"};
+}
+#endif
+
+
+//! @brief Namespace containing the libraries of coordination routines.
+namespace coordination {
+
+//! @brief Tags used in the node storage.
+namespace tags {
+    //! @brief Inner color band of the current node.
+    struct node_color_in {};
+    //! @brief Outer color bands of the current node.
+    struct node_color_out {};
+    //! @brief Size of the shadow of the current node.
+    struct node_shadow{};
+    //! @brief Size of the current node.
+    struct node_size {};
+    //! @brief Shape of the current node.
+    struct node_shape {};
+    //! @brief Value computed for the hop-count distance.
+    struct hop_dist {};
+    //! @brief Value computed for the hop-count diameter.
+    struct hop_diam {};
+    //! @brief Value computed for the stabilised real distance.
+    struct stable_dist {};
+    //! @brief Value computed for the stabilised real diameter.
+    struct stable_diam {};
+    //! @brief Maximum number of neighbours listened to (0 for no bound).
+    struct degree {};
+    //! @brief Whether rounds are stretched while values are stable.
+    struct adaptive {};
+    //! @brief Number of rounds performed.
+    struct rounds {};
+    //! @brief Current interval between rounds (in mean rounds).
+    struct round_interval {};
+    //! @brief Parameters of the scenario.
+    struct scenario {};
+    //! @brief Number of nodes spawned.
+    struct spawn_count {};
+    //! @brief End of the rounds of nodes.
+    struct round_end {};
+    //! @brief End of the logs.
+    struct log_end {};
+    //! @brief Side of the area where nodes are spawned.
+    struct area_side {};
+    //! @brief The maximum communication range between nodes.
+    struct comm_radius {};
+    //! @brief Bytes of the node object (including its storage) and of the debug string.
+    struct node_bytes {};
+    //! @brief Bytes of the latest export of the node, kept as the state of old and nbr.
+    struct export_bytes {};
+    //! @brief Estimated bytes of the messages retained from neighbours.
+    struct retained_bytes {};
+    //! @brief Bytes of gossip dictionaries in the whole network, per node.
+    struct gossip_bytes {};
+    //! @brief Compressor of the values sent and received.
+    struct compressor {};
+}
+
+#if FCPP_CASE_STUDY_RUNTIME
+//! @brief The parameters of the scenario of a node, read at run time.
+template <typename node_t>
+parameters const& scenario_parameters(node_t const& node) {
+    return *node.storage(tags::scenario{});
+}
+#else
+//! @brief The parameters of the scenario, fixed at compile time.
+constexpr parameters fixed_scenario{};
+
+//! @brief The parameters of the scenario of a node, fixed at compile time.
+template <typename node_t>
+constexpr parameters const& scenario_parameters(node_t const&) {
+    return fixed_scenario;
+}
+#endif
+
+//! @brief Main function.
+MAIN() {
+    // import tag names in the local scope.
+    using namespace tags;
+    // the parameters of the scenario
+    parameters const& sc = scenario_parameters(node);
+    FCPP_SPAN("round");
+#ifdef FCPP_METRICS
+    metrics::timer round_timer(metrics::round_ns);
+#endif
+#ifdef FCPP_TRACE
+    trace::messages(node);
+#endif
+
+    // change source every conv_time simulated seconds
+    device_t sid = min(node.current_time() / sc.conv_time, sc.source_num - 1.0);
+    // fixed positions for leaders
+    if (node.uid < sc.source_num) node.position() = sc.source_pos[node.uid];
+
+    // call the algorithms (with bounded degree if required, k >= node_num bounding nothing)
+    size_t k = node.storage(degree{});
+    field<bool> m = k == 0 ? field<bool>(true) : nearest(CALL, k);
+    diam_data hd = k == 0 ? hop_diameter(CALL, sc.discard_time) : bounded_hop_diameter(CALL, sc.discard_time, m);
+    diam_data sd = k == 0 ? stable_diameter(CALL, sid == node.uid) : bounded_stable_diameter(CALL, sid == node.uid, m);
+
+    // adjust hop-counts to be measurable as distances
+    get<1>(hd) *= sc.comm_range;
+    get<2>(hd) *= sc.comm_range;
+
+#ifdef FCPP_COMPRESSION
+    // send the values computed compressed, checking how neighbours decode them
+    compressed_exchange(CALL, node.storage(compressor{}), tuple<diam_data, diam_data>(hd, sd));
+#endif
+
+#ifdef FCPP_METRICS
+    // update metrics
+    metrics::rounds.add();
+    // messages received since the previous round (retained ones were already counted, the device itself excluded)
+    size_t received = 0;
+    map_hood([&](device_t d, times_t lag){
+        if (d != node.uid and node.current_time() - lag > node.previous_time()) ++received;
+        return 0;
+    }, node.nbr_uid(), node.nbr_lag());
+    metrics::messages.add(received);
+    metrics::bytes.add(node.msg_size());
+    if (node.storage(hop_dist{}) != get<1>(hd) or node.storage(hop_diam{}) != get<2>(hd)) metrics::changes.add();
+    metrics::simulated_time.set(node.current_time());
+#endif
+
+    // display computed values in the storage
+    node.storage(hop_dist{}) = get<1>(hd);
+    node.storage(hop_diam{}) = get<2>(hd);
+    node.storage(stable_dist{}) = get<1>(sd);
+    node.storage(stable_diam{}) = get<2>(sd);
+#if FCPP_CASE_STUDY_RENDER
+    node.storage(node_shadow{}) = 40*get<0>(sd);
+    node.storage(node_size{}) = 10 + 10*get<0>(hd);
+    node.storage(node_color_in{})  = color::hsva(get<1>(hd) * sc.hue_factor(), 1, 1);
+    node.storage(node_color_out{}) = color::hsva(get<1>(sd) * sc.hue_factor(), 1, 1);
+    node.storage(node_shape{}) = get<0>(sd) ? shape::cube : get<0>(hd) ? shape::octahedron : shape::sphere;
+#endif
+
+    // stretch the interval between rounds while converged values and neighbourhood are stable
+    node.storage(rounds{}) += 1;
+    if (node.storage(adaptive{})) {
+        size_t n = details::get_ids(node.nbr_uid()).size();
+        // the stabilised distance is a running average, hence never stable
+        bool stable = unchanged(CALL, tuple<real_t, real_t, size_t>(get<1>(hd), get<2>(hd), n));
+        stable = steady(CALL, get<2>(sd), stable_tolerance) and stable;
+        times_t i = adaptive_interval(CALL, stable, 1, max_interval);
+        node.storage(round_interval{}) = i;
+        if (i > 1) node.next_time(node.current_time() + i * round_mean / 10.0);
+    }
+
+#ifdef FCPP_MEMORY
+    // account memory, estimating the size of neighbour messages from the size of the own one
+    // (field values start with the default one, and ids include the device itself)
+    size_t nbrs = details::get_ids(node.nbr_uid()).size() - 1;
+    node.storage(node_bytes{}) = sizeof(node) + memory::footprint(node.storage(debug{}));
+    node.storage(export_bytes{}) = node.msg_size();
+    node.storage(retained_bytes{}) = node.msg_size() * nbrs;
+    node.storage(gossip_bytes{}) = memory::live<gossip>() / real_t(sc.node_num);
+#endif
+
+    // killing the former sources
+    if (node.uid < sid and node.current_time() < sc.end_time) {
+        // removing them from the network unless they are kept as dormant
+        // (their messages are still used by neighbours until they expire)
+        if (not dormant_sources) {
+            node.terminate();
+            return;
+        }
+        node.next_time(sc.end_time+2);
+        node.storage(hop_diam{}) = NAN;
+        node.storage(stable_diam{}) = NAN;
+#if FCPP_CASE_STUDY_RENDER
+        node.storage(node_color_in{}) = node.storage(node_color_out{}) = color(GRAY);
+        node.storage(node_shape{}) = shape::icosahedron;
+        node.storage(node_shadow{}) = 0;
+#endif
+    }
+}
+//! @brief Export types used by the main function (update it when expanding the program).
+FUN_EXPORT main_t = export_list<hop_diameter_t, stable_diameter_t, bounded_hop_diameter_t, bounded_stable_diameter_t, compressed_exchange_t, unchanged_t<tuple<real_t, real_t, size_t>>, steady_t, adaptive_interval_t>;
+
+} // namespace coordination
+
+
+// SYSTEM SETUP
+
+//! @brief Namespace for component options.
+namespace option {
+
+//! @brief Import tags to be used for component options.
+using namespace component::tags;
+//! @brief Import tags used by aggregate functions.
+using namespace coordination::tags;
+
+#if FCPP_CASE_STUDY_RUNTIME
+//! @brief Description of the round schedule.
+using round_s = sequence::periodic<
+    distribution::interval_n<times_t, 0, 1>,      // uniform time in the [0,1] interval for start
+    distribution::weibull_n<times_t, round_mean, round_dev, 10>, // weibull-distributed time for interval (10/10=1 mean, 1/10=0.1 deviation)
+    distribution::constant_i<times_t, round_end>  // the end is read from the network parameters
+>;
+//! @brief The sequence of network snapshots (one every simulated second).
+using log_s = sequence::periodic<
+    distribution::constant_n<times_t, 0>,       // the constant 0 number for start
+    distribution::constant_n<times_t, 1>,       // the constant 1 number for interval
+    distribution::constant_i<times_t, log_end>  // the end is read from the network parameters
+>;
+//! @brief The sequence of node generation events (all generated at time 0, as many as read from the network parameters).
+using spawn_s = sequence::multiple<distribution::constant_i<size_t, spawn_count>, distribution::constant_n<times_t, 0>>;
+//! @brief The distribution of initial node positions (random in a square, whose side is read from the network parameters).
+using rectangle_d = distribution::cube_i<area_side, dim>;
+//! @brief Connection allowed within a comm range read from the network parameters.
+using connector_t = connect::fixed_i<comm_radius, dim>;
+#else
+//! @brief Description of the round schedule.
+using round_s = sequence::periodic<
+    distribution::interval_n<times_t, 0, 1>,      // uniform time in the [0,1] interval for start
+    distribution::weibull_n<times_t, round_mean, round_dev, 10>, // weibull-distributed time for interval (10/10=1 mean, 1/10=0.1 deviation)
+    distribution::constant_n<times_t, end_time+2> // the constant end_time+2 number for end
+>;
+//! @brief The sequence of network snapshots (one every simulated second).
+using log_s = sequence::periodic_n<1, 0, 1, end_time>;
+//! @brief The sequence of node generation events (node_num devices all generated at time 0).
+using spawn_s = sequence::multiple_n<node_num, 0>;
+//! @brief The distribution of initial node positions (random in a square).
+using rectangle_d = distribution::rect_n<1, 0, 0, size, size>;
+//! @brief Connection allowed within a fixed comm range.
+using connector_t = connect::fixed<comm_range, 1, dim>;
+#endif
+//! @brief The contents of the node storage as tags and associated types.
+using store_t = tuple_store<
+#if FCPP_CASE_STUDY_RENDER
+    node_color_in,              color,
+    node_color_out,             color,
+    node_shadow,                double,
+    node_size,                  double,
+    node_shape,                 shape,
+#endif
+    hop_dist,                   real_t,
+    hop_diam,                   real_t,
+    stable_dist,                real_t,
+    stable_diam,                real_t,
+    degree,                     size_t,
+    adaptive,                   bool,
+    rounds,                     size_t,
+    round_interval,             times_t,
+#ifdef FCPP_MEMORY
+    node_bytes,                 real_t,
+    export_bytes,               real_t,
+    retained_bytes,             real_t,
+    gossip_bytes,               real_t,
+#endif
+    debug,                      std::string
+>;
+//! @brief The tags and corresponding aggregators to be logged (change as needed).
+using aggregator_t = aggregators<
+    hop_dist,                   aggregator::max<real_t>,
+    stable_dist,                aggregator::combine<aggregator::max<real_t>, aggregator::kahan_mean<real_t>>,
+    hop_diam,                   aggregator::combine<aggregator::min<real_t>, aggregator::max<real_t>>,
+    stable_diam,                aggregator::combine<aggregator::min<real_t>, aggregator::max<real_t>>,
+    rounds,                     aggregator::sum<size_t>,
+#ifdef FCPP_MEMORY
+    node_bytes,                 aggregator::mean<real_t>,
+    export_bytes,               aggregator::mean<real_t>,
+    retained_bytes,             aggregator::mean<real_t>,
+    gossip_bytes,               aggregator::mean<real_t>,
+#endif
+    round_interval,             aggregator::mean<times_t>
+>;
+
+//! @brief The aggregator to be used on logging rows for plotting.
+using row_aggregator_t = common::type_sequence<aggregator::mean<double>>;
+//! @brief Plot of the diameters over time.
+using diam_plot_t = plot::split<plot::time, plot::values<aggregator_t, row_aggregator_t, hop_diam, stable_diam>>;
+#ifdef FCPP_MEMORY
+//! @brief Plot of the memory per node over time.
+using memory_plot_t = plot::split<plot::time, plot::values<aggregator_t, row_aggregator_t, node_bytes, export_bytes, retained_bytes, gossip_bytes>>;
+//! @brief Combining the plots into a single row, for every degree bound.
+using plot_t = plot::split<degree, plot::join<diam_plot_t, memory_plot_t>>;
+#else
+//! @brief Combining the plots into a single row, for every degree bound.
+using plot_t = plot::split<degree, diam_plot_t>;
+#endif
+
+#if FCPP_CASE_STUDY_RENDER
+//! @brief The options for rendering nodes.
+DECLARE_OPTIONS(render_options,
+    shape_tag<node_shape>, // the shape of a node is read from this tag in the store
+    size_tag<node_size>,   // the size  of a node is read from this tag in the store
+    shadow_size_tag<node_shadow>, // the size of the shadow of a node is read from this tag
+    shadow_shape_val<(int)shape::sphere>, // the shadow of nodes are circular
+    shadow_color_val<DARK_SLATE_GRAY>,    // the shadow of nodes are in dark slate gray
+    color_tag<node_color_in, node_color_out> // node colors are read from these tags in the store
+);
+#else
+//! @brief No options for rendering nodes in headless executables.
+using render_options = common::type_sequence<>;
+#endif
+
+#if FCPP_CASE_STUDY_RUNTIME
+//! @brief The options for reading the scenario at run time.
+DECLARE_OPTIONS(runtime_options,
+    tuple_store<scenario, parameters const*>, // the scenario is referenced in the node storage
+    init<scenario, distribution::constant_i<parameters const*, scenario>> // the scenario is read from the network parameters
+);
+#else
+//! @brief No options for reading the scenario at run time.
+using runtime_options = common::type_sequence<>;
+#endif
+
+#if defined(FCPP_MEMORY) or defined(FCPP_METRICS)
+//! @brief The options for memory accounting and metrics.
+DECLARE_OPTIONS(size_options,
+    message_size<true> // the size of messages is computed
+);
+#else
+//! @brief No options for memory accounting and metrics.
+using size_options = common::type_sequence<>;
+#endif
+
+#ifdef FCPP_COMPRESSION
+//! @brief The options for compressing the values sent.
+DECLARE_OPTIONS(compression_options,
+    tuple_store<compressor, export_compressor> // the compressor is kept in the node storage
+);
+#else
+//! @brief No options for compressing the values sent.
+using compression_options = common::type_sequence<>;
+#endif
+
+//! @brief The simulation options shared by every network, except for the retention of messages.
+DECLARE_OPTIONS(base_options,
+    parallel<FCPP_CASE_STUDY_PARALLEL>, // multithreading enabled on node rounds (unless the network is forked)
+    synchronised<false>, // optimise for asynchronous networks
+    program<coordination::main>,   // program to be run (refers to MAIN above)
+    exports<coordination::main_t>, // export type list (types used in messages)
+    round_schedule<round_s>, // the sequence generator for round events on nodes
+    log_schedule<log_s>,     // the sequence generator for log events on the network
+    spawn_schedule<spawn_s>, // the sequence generator of node creation events on the network
+    store_t,       // the contents of the node storage
+    aggregator_t,  // the tags and corresponding aggregators to be logged
+    plot_type<plot_t>, // the plot description to be used
+    extra_info<degree, size_t, adaptive, bool>, // the degree bound and adaptivity are logged with the results
+    init<
+        x,      rectangle_d, // initialise position randomly in a rectangle for new nodes
+        degree, distribution::constant_i<size_t, degree>, // the degree bound is read from the network parameters
+        adaptive, distribution::constant_i<bool, adaptive>, // whether rounds are adaptive is read from the network parameters
+        round_interval, distribution::constant_n<times_t, 1> // rounds start at the base interval
+    >,
+    dimension<dim>, // dimensionality of the space
+    connector<connector_t>, // connection allowed within a comm range
+    render_options,  // how nodes are rendered (if they are)
+    size_options,    // whether message sizes are computed (for memory accounting and metrics)
+    compression_options, // whether the values sent are also compressed
+    runtime_options  // whether the scenario is read at run time
+);
+
+//! @brief The general simulation options.
+DECLARE_OPTIONS(list,
+    base_options,
+    retain<metric::retain<retain_rounds * round_mean, 10>> // messages are kept for 3 rounds before expiring (3 seconds)
+);
+
+//! @brief The simulation options for networks with adaptive rounds, whose stable neighbours may wait up to max_interval between rounds.
+DECLARE_OPTIONS(adaptive_list,
+    base_options,
+    retain<metric::retain<retain_rounds * max_interval * round_mean, 10>> // messages are kept for 3 maximum intervals before expiring (24 seconds)
+);
+
+} // namespace option
+
+} // namespace fcpp
+
+
+#endif // FCPP_CASE_STUDY_H_
@@ -0,0 +1,165 @@
+// Copyright © 2025 Giorgio Audrito. All Rights Reserved.
+
+/**
+ * @file checkpoint.hpp
+ * @brief Checkpointing of running simulations through process forking.
+ *
+ * A forked process holds the whole state of a network (storage, aggregate state, retained
+ * messages, random generators and event queue) and shares it copy-on-write with its parent,
+ * so that many runs can continue from a warm state without repeating the warm-up.
+ * Networks should be batch (non-interactive) simulations, stepped only between forks, and should
+ * run their rounds sequentially (`parallel<false>`): a forked process only keeps the thread calling
+ * fork, so that locks held by other threads at that time would never be released.
+ */
+
+#ifndef FCPP_CHECKPOINT_H_
+#define FCPP_CHECKPOINT_H_
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+//! Importing the FCPP library.
+#include "lib/fcpp.hpp"
+
+
+/**
+ * @brief Namespace containing all the objects in the FCPP library.
+ */
+namespace fcpp {
+
+
+//! @brief Runs a network until every event scheduled before a given time has been processed.
+template <typename net_t>
+void run_until(net_t& network, times_t t) {
+    while (network.next() < t) network.update();
+}
+
+
+/**
+ * @brief Whether every node with identifier below `n` agrees on the same value in a given storage tag.
+ *
+ * Nodes holding a NaN value (not yet computed) are ignored.
+ */
+template <typename T, typename net_t>
+bool agreement(net_t& network, device_t n) {
+    real_t lo = INF, hi = -INF;
+    for (device_t uid = 0; uid < n; ++uid)
+        if (network.node_count(uid)) {
+            real_t d = network.node_at(uid).storage(T{});
+            if (std::isnan(d)) continue;
+            lo = std::min(lo, d);
+            hi = std::max(hi, d);
+        }
+    return lo == hi;
+}
+
+
+/**
+ * @brief Forks the current process into `n` branches sharing its state.
+ *
+ * The standard output of branch `i` is redirected to file `<prefix>-<i>.txt`, whose directory is created if missing.
+ * Returns the branch index in every child, and -1 in the parent after all children have terminated,
+ * setting `failed` to the number of branches which did not exit successfully.
+ */
+inline int branch(size_t n, std::string const& prefix, size_t& failed) {
+    std::filesystem::path dir = std::filesystem::path(prefix).parent_path();
+    if (not dir.empty()) std::filesystem::create_directories(dir);
+    std::cout.flush();
+    std::fflush(stdout);
+    std::vector<pid_t> children;
+    for (size_t i = 0; i < n; ++i) {
+        pid_t pid = fork();
+        if (pid < 0) throw std::system_error(errno, std::generic_category(), "fork");
+        if (pid == 0) {
+            std::string file = prefix + "-" + std::to_string(i) + ".txt";
+            int fd = open(file.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+            if (fd < 0) {
+                std::perror(file.c_str());
+                _exit(1);
+            }
+            dup2(fd, STDOUT_FILENO);
+            close(fd);
+            return i;
+        }
+        children.push_back(pid);
+    }
+    failed = 0;
+    for (pid_t pid : children) {
+        int status;
+        if (waitpid(pid, &status, 0) != pid or not WIFEXITED(status) or WEXITSTATUS(status) != 0) ++failed;
+    }
+    return -1;
+}
+
+
+/**
+ * @brief Forks the current process into `n` children, collecting their results.
+ *
+ * Child `i` computes `f(i)` from the current state and streams it back through a pipe,
+ * to be passed to `g(i, result)` in the parent as soon as the child terminates.
+ * At most `width` children run at the same time.
+ * Returns the number of children which did not exit successfully or did not send a whole result,
+ * for which `g` is not called.
+ */
+template <typename T, typename F, typename G>
+size_t fork_map(size_t n, size_t width, F&& f, G&& g) {
+    static_assert(std::is_trivially_copyable<T>::value, "results must be trivially copyable");
+    std::cout.flush();
+    std::fflush(stdout);
+    std::vector<std::pair<pid_t, int>> running;
+    std::vector<size_t> index;
+    size_t failed = 0;
+    auto collect = [&](){
+        int status;
+        pid_t pid;
+        while ((pid = waitpid(-1, &status, 0)) < 0 and errno == EINTR);
+        if (pid < 0) throw std::system_error(errno, std::generic_category(), "waitpid");
+        size_t j = std::find_if(running.begin(), running.end(), [pid](auto const& c){
+            return c.first == pid;
+        }) - running.begin();
+        if (j == running.size()) return;
+        T r;
+        if (WIFEXITED(status) and WEXITSTATUS(status) == 0 and read(running[j].second, &r, sizeof(T)) == sizeof(T))
+            g(index[j], r);
+        else ++failed;
+        close(running[j].second);
+        running.erase(running.begin() + j);
+        index.erase(index.begin() + j);
+    };
+    for (size_t i = 0; i < n; ++i) {
+        while (running.size() >= std::max<size_t>(width, 1)) collect();
+        int fd[2];
+        if (pipe(fd) < 0) throw std::system_error(errno, std::generic_category(), "pipe");
+        pid_t pid = fork();
+        if (pid < 0) throw std::system_error(errno, std::generic_category(), "fork");
+        if (pid == 0) {
+            close(fd[0]);
+            T r = f(i);
+            bool ok = write(fd[1], &r, sizeof(T)) == sizeof(T);
+            _exit(ok ? 0 : 1);
+        }
+        close(fd[1]);
+        running.emplace_back(pid, fd[0]);
+        index.push_back(i);
+    }
+    while (running.size()) collect();
+    return failed;
+}
+
+
+} // namespace fcpp
+
+
+#endif // FCPP_CHECKPOINT_H_
@@ -0,0 +1,301 @@
+// Copyright © 2025 Giorgio Audrito. All Rights Reserved.
+
+/**
+ * @file compression.hpp
+ * @brief Compression of serialised exports, exploiting their similarity across rounds.
+ *
+ * Every export is XOR-ed with the latest full (key) export of the same device, so that unchanged
+ * bytes become zeros, which are then run-length encoded. Exports identical to the previous one are
+ * replaced by a marker, resolved by receivers from their retained copy. Key exports are sent
+ * periodically, so that receivers missing them can resynchronise, while missing other exports
+ * does not prevent receivers from decoding the following ones.
+ * The serialised export itself is internal to the FCPP calculus component, hence `compressed_exchange`
+ * measures compression on the values computed by a round, sent to neighbours through `nbr` in addition
+ * to the regular export (whose values, unchanged or not, are still sent in full).
+ */
+
+#ifndef FCPP_COMPRESSION_H_
+#define FCPP_COMPRESSION_H_
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <unordered_map>
+#include <vector>
+
+//! Importing the FCPP library.
+#include "lib/fcpp.hpp"
+
+
+/**
+ * @brief Namespace containing all the objects in the FCPP library.
+ */
+namespace fcpp {
+
+
+//! @brief Statistics on the compression of exports.
+struct compression_stats {
+    //! @brief Number of exports processed.
+    size_t messages = 0;
+    //! @brief Number of exports sent as unchanged markers.
+    size_t unchanged = 0;
+    //! @brief Total size of exports before compression.
+    size_t raw_bytes = 0;
+    //! @brief Total size of exports after compression.
+    size_t compressed_bytes = 0;
+    //! @brief Total time spent (in seconds).
+    double seconds = 0;
+    //! @brief Number of exports received that could not be decoded.
+    size_t rejected = 0;
+    //! @brief Number of unchanged markers received resolved from an older export (having missed the latest).
+    size_t stale = 0;
+    //! @brief Number of exports received decoded to a different content than the one sent (at most the stale ones).
+    size_t mismatched = 0;
+
+    //! @brief Combines statistics.
+    compression_stats& operator+=(compression_stats const& o) {
+        messages += o.messages;
+        unchanged += o.unchanged;
+        raw_bytes += o.raw_bytes;
+        compressed_bytes += o.compressed_bytes;
+        seconds += o.seconds;
+        rejected += o.rejected;
+        stale += o.stale;
+        mismatched += o.mismatched;
+        return *this;
+    }
+
+    //! @brief Ratio between raw and compressed sizes.
+    real_t ratio() const {
+        return compressed_bytes == 0 ? 1 : raw_bytes / real_t(compressed_bytes);
+    }
+
+    //! @brief Prints the statistics.
+    friend std::ostream& operator<<(std::ostream& o, compression_stats const& s) {
+        return o << "messages: " << s.messages << ", unchanged: " << s.unchanged << ", raw bytes: " << s.raw_bytes << ", compressed bytes: " << s.compressed_bytes
+                 << ", ratio: " << s.ratio() << ", ns/message: " << (s.messages ? s.seconds * 1e9 / s.messages : 0)
+                 << ", rejected: " << s.rejected << ", stale: " << s.stale << ", mismatched: " << s.mismatched;
+    }
+};
+
+
+//! @brief Implementation details.
+namespace details {
+    //! @brief Appends an unsigned integer in variable-length encoding.
+    inline void put_varint(std::vector<char>& v, size_t x) {
+        while (x >= 128) {
+            v.push_back(char((x & 127) | 128));
+            x >>= 7;
+        }
+        v.push_back(char(x));
+    }
+
+    //! @brief Reads an unsigned integer in variable-length encoding, advancing the position.
+    inline size_t get_varint(std::vector<char> const& v, size_t& i) {
+        size_t x = 0;
+        for (int s = 0; i < v.size(); s += 7) {
+            uint8_t b = v[i++];
+            x |= size_t(b & 127) << s;
+            if (b < 128) break;
+        }
+        return x;
+    }
+
+    //! @brief The statistics of all compressors destroyed.
+    struct totals {
+        std::mutex mutex;
+        compression_stats stats;
+    };
+
+    //! @brief The global statistics.
+    inline totals& compression_totals() {
+        static totals t;
+        return t;
+    }
+}
+
+
+/**
+ * @brief Compressor and decompressor of exports, keeping the latest key export and the previous export of every device.
+ *
+ * Encoded exports start with a flag (0 for key exports, 1 for deltas, 2 for unchanged markers) and the
+ * sequence number of the export. Deltas follow with the sequence number of the key export they are XOR-ed
+ * with, so that a receiver can resolve them as long as it holds that key, whatever messages it missed since.
+ * Markers follow with the sequence number N of the last export carrying content ("unchanged since N"): if the
+ * receiver missed that export, the marker falls back to the last export it resolved (counted as stale), which
+ * is the same as reusing an older retained message. To bound staleness, unchanged exports are sent as deltas
+ * again after a given number of consecutive markers. Key exports and deltas end with the raw size and the
+ * (XOR-ed) bytes, where non-zero bytes are copied and runs of zeros become a zero and their length.
+ */
+class export_compressor {
+  public:
+    //! @brief Constructor, given the number of exports between two key exports and the maximum number of consecutive markers.
+    export_compressor(size_t key_interval = 16, size_t marker_run = 4) : m_key_interval(key_interval), m_marker_run(marker_run) {}
+
+    //! @brief Destructor, adding the statistics to the global ones.
+    ~export_compressor() {
+        details::totals& t = details::compression_totals();
+        std::lock_guard<std::mutex> lock(t.mutex);
+        t.stats += m_stats;
+    }
+
+    //! @brief Compresses the export of a device.
+    std::vector<char> encode(device_t uid, std::vector<char> const& data) {
+        auto start = std::chrono::steady_clock::now();
+        state& st = m_state[uid];
+        bool key = st.count % m_key_interval == 0 or st.reference.empty();
+        bool same = not key and st.markers < m_marker_run and data == st.previous;
+        std::vector<char> out;
+        out.push_back(key ? 0 : same ? 2 : 1);
+        details::put_varint(out, st.count);
+        if (same) {
+            details::put_varint(out, st.base);
+            ++st.count;
+            ++st.markers;
+            ++m_stats.unchanged;
+            record(data.size(), out.size(), start);
+            return out;
+        }
+        if (not key) details::put_varint(out, st.key);
+        details::put_varint(out, data.size());
+        std::vector<char> const& ref = st.reference;
+        auto byte = [&](size_t i) -> char {
+            return key or i >= ref.size() ? data[i] : data[i] ^ ref[i];
+        };
+        for (size_t i = 0; i < data.size();) {
+            if (byte(i) != 0) {
+                out.push_back(byte(i++));
+                continue;
+            }
+            size_t j = i;
+            while (j < data.size() and byte(j) == 0) ++j;
+            out.push_back(0);
+            details::put_varint(out, j - i);
+            i = j;
+        }
+        if (key) {
+            st.reference = data;
+            st.key = st.count;
+        }
+        st.previous = data;
+        st.base = st.count++;
+        st.markers = 0;
+        record(data.size(), out.size(), start);
+        return out;
+    }
+
+    //! @brief Decompresses an export received from a device (empty if it is a delta from a key export not received).
+    std::vector<char> decode(device_t uid, std::vector<char> const& data) {
+        if (data.empty()) return {};
+        state& st = m_state[uid];
+        size_t i = 1;
+        size_t seq = details::get_varint(data, i);
+        if (data[0] == 2) {
+            if (details::get_varint(data, i) != st.base and not st.previous.empty()) ++m_stats.stale;
+            return st.previous;
+        }
+        bool key = data[0] == 0;
+        if (not key and (st.reference.empty() or details::get_varint(data, i) != st.key)) return {};
+        std::vector<char> out(details::get_varint(data, i));
+        for (size_t j = 0; i < data.size() and j < out.size();) {
+            if (data[i] != 0) {
+                out[j++] = data[i++];
+                continue;
+            }
+            ++i;
+            j += details::get_varint(data, i);
+        }
+        if (key) {
+            st.reference = out;
+            st.key = seq;
+        } else for (size_t j = 0; j < out.size() and j < st.reference.size(); ++j)
+            out[j] ^= st.reference[j];
+        st.previous = out;
+        st.base = seq;
+        return out;
+    }
+
+    //! @brief Decompresses an export received from a device, checking it against the raw export sent.
+    void check(device_t uid, std::vector<char> const& data, std::vector<char> const& raw) {
+        std::vector<char> out = decode(uid, data);
+        if (out.empty()) ++m_stats.rejected;
+        else if (out != raw) ++m_stats.mismatched;
+    }
+
+    //! @brief Statistics on the exports compressed and checked so far.
+    compression_stats const& stats() const {
+        return m_stats;
+    }
+
+    //! @brief Statistics of all compressors destroyed so far.
+    static compression_stats total() {
+        details::totals& t = details::compression_totals();
+        std::lock_guard<std::mutex> lock(t.mutex);
+        return t.stats;
+    }
+
+  private:
+    //! @brief Compression state for a device.
+    struct state {
+        //! @brief The latest key export.
+        std::vector<char> reference;
+        //! @brief The previous export carrying content.
+        std::vector<char> previous;
+        //! @brief The number of exports processed.
+        size_t count = 0;
+        //! @brief The sequence number of the latest key export.
+        size_t key = 0;
+        //! @brief The sequence number of the previous export carrying content.
+        size_t base = 0;
+        //! @brief The number of consecutive markers sent since then.
+        size_t markers = 0;
+    };
+
+    //! @brief Records statistics for a compressed export.
+    void record(size_t raw, size_t compressed, std::chrono::steady_clock::time_point start) {
+        m_stats.messages += 1;
+        m_stats.raw_bytes += raw;
+        m_stats.compressed_bytes += compressed;
+        m_stats.seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    //! @brief Number of exports between two key exports.
+    size_t m_key_interval;
+    //! @brief Maximum number of consecutive markers.
+    size_t m_marker_run;
+    //! @brief Compression state for every device.
+    std::unordered_map<device_t, state> m_state;
+    //! @brief Compression statistics.
+    compression_stats m_stats;
+};
+
+
+//! @brief Namespace containing the libraries of coordination routines.
+namespace coordination {
+
+
+//! @brief Sends the serialisation of a value to neighbours compressed by c (together with the raw one), checking how new messages are decoded.
+template <typename node_t, typename T>
+void compressed_exchange(ARGS, export_compressor& c, T const& v) { CODE
+    common::osstream os;
+    os << v;
+    std::vector<char> raw = os.data();
+    field<tuple<std::vector<char>, std::vector<char>>> n = nbr(CALL, tuple<std::vector<char>, std::vector<char>>(c.encode(node.uid, raw), raw));
+    // messages already received in a previous round are skipped
+    map_hood([&](device_t d, times_t lag, tuple<std::vector<char>, std::vector<char>> const& m){
+        if (d != node.uid and node.current_time() - lag > node.previous_time()) c.check(d, get<0>(m), get<1>(m));
+        return 0;
+    }, node.nbr_uid(), node.nbr_lag(), n);
+}
+//! @brief Export list for function compressed_exchange.
+FUN_EXPORT compressed_exchange_t = export_list<tuple<std::vector<char>, std::vector<char>>>;
+
+
+} // namespace coordination
+
+
+} // namespace fcpp
+
+
+#endif // FCPP_COMPRESSION_H_
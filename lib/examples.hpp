@@ -12,6 +12,9 @@
 
 //! Importing the FCPP library.
 #include "lib/fcpp.hpp"
+#include "lib/fixed.hpp"
+#include "lib/memory.hpp"
+#include "lib/trace.hpp"
 
 
 /**
@@ -27,6 +30,8 @@ namespace coordination {
 namespace tags {
     //! @brief String value for debugging.
     struct debug {};
+    //! @brief Memory category of time_dict values.
+    struct gossip {};
 }
 
 
@@ -36,11 +41,23 @@ namespace tags {
 //! @brief Maximum valid value for a hops_t variable.
 constexpr hops_t HOPS_MAX = std::numeric_limits<hops_t>::max() - 1;
 
-//! @brief A dictionary associating keys with timestamp to device IDs.
+/**
+ * @brief Default type of the real values held and exported by the stabilised functions.
+ *
+ * The type used by rdist, integrate, lowpass, maxgossip and stable_diameter is their first template parameter,
+ * which can be set to `float` or to a fixed-point type (e.g., `fcpp::fixed<int32_t, 256>`) to reduce the size of exports.
+ */
+using stable_t = real_t;
+
+//! @brief A dictionary associating keys with timestamp to device IDs (accounted in the gossip category if FCPP_MEMORY is defined).
+#ifdef FCPP_MEMORY
+using time_dict = std::unordered_map<device_t, std::pair<times_t, real_t>, std::hash<device_t>, std::equal_to<device_t>, memory::allocator<std::pair<device_t const, std::pair<times_t, real_t>>, tags::gossip>>;
+#else
 using time_dict = std::unordered_map<device_t, std::pair<times_t, real_t>>;
+#endif
 
 //! @brief Merges two time_dict by preferring the most recent values for each key.
-time_dict update(time_dict x, time_dict const& y) {
+inline time_dict update(time_dict x, time_dict const& y) {
     // updates values in x with more recent values in y
     for (auto& kv : x)
         if (y.count(kv.first) and y.at(kv.first).first > kv.second.first)
@@ -53,7 +70,7 @@ time_dict update(time_dict x, time_dict const& y) {
 }
 
 //! @brief Discards obsolete keys in a time_dict.
-time_dict& discard(time_dict& x, times_t t) {
+inline time_dict& discard(time_dict& x, times_t t) {
     for (auto it = x.begin(); it != x.end();)
         if (it->second.first < t) it = x.erase(it);
         else ++it;
@@ -61,7 +78,7 @@ time_dict& discard(time_dict& x, times_t t) {
 }
 
 //! @brief Computes the maximum value in a time_dict.
-real_t max_value(time_dict const& dict) {
+inline real_t max_value(time_dict const& dict) {
     real_t val = 0;
     for (auto const& kv : dict)
         val = max(val, kv.second.second);
@@ -81,27 +98,32 @@ times_t delta_time(node_t const& node) {
 //! @{
 
 //! @brief Computes low-pass filtering of a real argument (SI-TI).
-FUN real_t lowpass(ARGS, real_t v) { CODE
-    return old(CALL, v, [&](real_t x){
-        return (x+v)/2;
+template <typename R = stable_t, typename node_t>
+real_t lowpass(ARGS, real_t v) { CODE
+    FCPP_SPAN("lowpass");
+    return old(CALL, R(v), [&](R x){
+        return R((x+v)/2);
     });
 }
-//! @brief Export list for function lowpass.
-FUN_EXPORT lowpass_t = export_list<real_t>;
+//! @brief Export list for function lowpass (with the default export type).
+FUN_EXPORT lowpass_t = export_list<stable_t>;
 
 
 //! @brief Integrates the values of the provided argument (SI-TC).
-FUN real_t integrate(ARGS, real_t v) { CODE
-    return old(CALL, 0, [&](real_t x){
-        return x + v * delta_time(node);
+template <typename R = stable_t, typename node_t>
+real_t integrate(ARGS, real_t v) { CODE
+    FCPP_SPAN("integrate");
+    return old(CALL, R(0), [&](R x){
+        return R(x + v * delta_time(node));
     });
 }
-//! @brief Export list for function integrate.
-FUN_EXPORT integrate_t = export_list<real_t>;
+//! @brief Export list for function integrate (with the default export type).
+FUN_EXPORT integrate_t = export_list<stable_t>;
 
 
 //! @brief Accumulates the values of the provided argument (SI-TD).
 FUN real_t accumulate(ARGS, real_t v) { CODE
+    FCPP_SPAN("accumulate");
     return old(CALL, 0, [&](real_t x){
         return x + v;
     });
@@ -111,17 +133,20 @@ FUN_EXPORT accumulate_t = export_list<real_t>;
 
 
 //! @brief Computes hop-count distances from the closest source device (SC-TI).
-FUN real_t rdist(ARGS, bool source) { CODE
-    return nbr(CALL, INF, [&](field<real_t> d){
-        return mux(source, real_t(0), min_hood(CALL, d + node.nbr_dist(), INF));
+template <typename R = stable_t, typename node_t>
+real_t rdist(ARGS, bool source) { CODE
+    FCPP_SPAN("rdist");
+    return nbr(CALL, R(INF), [&](field<R> d){
+        return R(mux(source, real_t(0), min_hood(CALL, d + node.nbr_dist(), INF)));
     });
 }
-//! @brief Export list for function rdist.
-FUN_EXPORT rdist_t = export_list<real_t>;
+//! @brief Export list for function rdist (with the default export type).
+FUN_EXPORT rdist_t = export_list<stable_t>;
 
 
 //! @brief Computes the maximum value of v in a network through timestamped gossiping (SC-TI).
 FUN real_t maximize(ARGS, real_t v, times_t threshold) { CODE
+    FCPP_SPAN("maximize");
     time_dict loc = {{node.uid, {node.current_time(),v}}};
     time_dict glob = nbr(CALL, loc, [&](field<time_dict> n){
         time_dict x = update(fold_hood(CALL, update, n), loc);
@@ -134,17 +159,20 @@ FUN_EXPORT maximize_t = export_list<time_dict>;
 
 
 //! @brief Computes the maximum value of v in the history of a network through basic gossiping (SC-TC).
-FUN real_t maxgossip(ARGS, real_t v) { CODE
-    return nbr(CALL, v, [&](field<real_t> n){
-        return max(max_hood(CALL, n), v);
+template <typename R = stable_t, typename node_t>
+real_t maxgossip(ARGS, real_t v) { CODE
+    FCPP_SPAN("maxgossip");
+    return nbr(CALL, R(v), [&](field<R> n){
+        return R(max(real_t(max_hood(CALL, n)), v));
     });
 }
-//! @brief Export list for function maxgossip.
-FUN_EXPORT maxgossip_t = export_list<real_t>;
+//! @brief Export list for function maxgossip (with the default export type).
+FUN_EXPORT maxgossip_t = export_list<stable_t>;
 
 
 //! @brief Computes hop-count distances from the closest source device (SD-TI).
 FUN hops_t dist(ARGS, bool source) { CODE
+    FCPP_SPAN("dist");
     return nbr(CALL, HOPS_MAX, [&](field<hops_t> d){
         return (hops_t)mux(source, 0, min_hood(CALL, d, HOPS_MAX) + 1);
     });
@@ -155,6 +183,7 @@ FUN_EXPORT dist_t = export_list<hops_t>;
 
 //! @brief Knowledge-free leader election as in Mo et al. (SD-TI).
 FUN bool election(ARGS) { CODE
+    FCPP_SPAN("election");
     // already implemented in the FCPP coordination library
     return wave_election(CALL) == node.uid;
 }
@@ -164,6 +193,7 @@ FUN_EXPORT election_t = export_list<wave_election_t<>>;
 
 //! @brief Implementation of the SLCS formula `a R (<>b)` (SD-TI).
 FUN bool closereach(ARGS, bool a, bool b) { CODE
+    FCPP_SPAN("closereach");
     // SCLS as implemented in the FCPP coordination library
     using namespace logic;
     return R(CALL, a, C(CALL, b));
@@ -174,6 +204,7 @@ FUN_EXPORT closereach_t = export_list<slcs_t>;
 
 //! @brief Integrates the values of the provided argument (SD-TC).
 FUN bool minintegral(ARGS, real_t v) { CODE
+    FCPP_SPAN("minintegral");
     real_t i = integrate(CALL, v);
     return i < min_hood(CALL, nbr(CALL, i), INF);
 }
@@ -183,6 +214,7 @@ FUN_EXPORT minintegral_t = export_list<integrate_t, real_t>;
 
 //! @brief Computes a counter that is collaboratively increased across the network (SD-TD).
 FUN int sharedcount(ARGS) { CODE
+    FCPP_SPAN("sharedcount");
     return nbr(CALL, 0, [&](field<int> n){
         return max_hood(CALL, n)+1;
     });
@@ -206,6 +238,7 @@ using diam_data = tuple<bool, real_t, real_t>;
  * Function in SD-TI, with Specification 1 (minimal) at T(I) = (4+2√2)Dt + threshold.
  */
 FUN diam_data hop_diameter(ARGS, times_t threshold) { CODE
+    FCPP_SPAN("hop_diameter");
     bool source = election(CALL);
     hops_t d = dist(CALL, source);
     real_t diam = maximize(CALL, d, threshold);
@@ -220,14 +253,16 @@ FUN_EXPORT hop_diameter_t = export_list<election_t, dist_t, maximize_t>;
  *
  * Function in SC-TC, that could comply to a form of Specification 4 (continuous).
  */
-FUN diam_data stable_diameter(ARGS, bool source) { CODE
-    real_t d = rdist(CALL, source);
+template <typename R = stable_t, typename node_t>
+diam_data stable_diameter(ARGS, bool source) { CODE
+    FCPP_SPAN("stable_diameter");
+    real_t d = rdist<R>(CALL, source);
     real_t z = d == INF ? 0 : d;
-    real_t avgd = integrate(CALL, z) / integrate(CALL, 1);
-    real_t diam = maxgossip(CALL, lowpass(CALL, avgd));
+    real_t avgd = integrate<R>(CALL, z) / integrate<R>(CALL, 1);
+    real_t diam = maxgossip<R>(CALL, lowpass<R>(CALL, avgd));
     return diam_data(source, avgd, diam);
 }
-//! @brief Export list for function stable_diameter.
+//! @brief Export list for function stable_diameter (with the default export type).
 FUN_EXPORT stable_diameter_t = export_list<rdist_t, integrate_t, lowpass_t, maxgossip_t>;
 
 //! @}
@@ -0,0 +1,74 @@
+// Copyright © 2025 Giorgio Audrito. All Rights Reserved.
+
+/**
+ * @file fixed.hpp
+ * @brief Fixed-point representation of real numbers, for compact exports.
+ */
+
+#ifndef FCPP_FIXED_H_
+#define FCPP_FIXED_H_
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+//! Importing the FCPP library.
+#include "lib/fcpp.hpp"
+
+
+/**
+ * @brief Namespace containing all the objects in the FCPP library.
+ */
+namespace fcpp {
+
+
+/**
+ * @brief Real number stored as an integer multiple of `1/den`.
+ *
+ * Values are rounded to the closest multiple, and saturate to infinity outside the representable range.
+ * Arithmetic is carried out on real_t, to which values convert implicitly.
+ */
+template <typename I, intmax_t den>
+class fixed {
+    static_assert(std::numeric_limits<I>::is_signed, "fixed-point values need a signed integral type");
+
+  public:
+    //! @brief The raw value representing positive infinity.
+    static constexpr I top = std::numeric_limits<I>::max();
+
+    //! @brief Default constructor (zero).
+    fixed() = default;
+
+    //! @brief Conversion from a real number.
+    fixed(real_t x) {
+        real_t r = std::round(x * den);
+        m_raw = r >= top ? top : r <= -top ? -top : std::isnan(r) ? 0 : I(r);
+    }
+
+    //! @brief Conversion to a real number.
+    operator real_t() const {
+        return m_raw == top ? INF : m_raw == -top ? -INF : m_raw / real_t(den);
+    }
+
+    //! @brief Serialises the content from/to a given input/output stream.
+    template <typename S>
+    S& serialize(S& s) {
+        return s & m_raw;
+    }
+
+    //! @brief Serialises the content from/to a given output stream (const overload).
+    template <typename S>
+    S& serialize(S& s) const {
+        return s << m_raw;
+    }
+
+  private:
+    //! @brief The raw integer value.
+    I m_raw = 0;
+};
+
+
+} // namespace fcpp
+
+
+#endif // FCPP_FIXED_H_
@@ -0,0 +1,135 @@
+// Copyright © 2025 Giorgio Audrito. All Rights Reserved.
+
+/**
+ * @file memory.hpp
+ * @brief Accounting of memory used by simulations, by category.
+ *
+ * Containers using a tracking allocator add the bytes they allocate to the counters of a category
+ * (any tag type), with relaxed atomic updates. The heap memory owned by other values can be estimated
+ * through the footprint functions.
+ */
+
+#ifndef FCPP_MEMORY_H_
+#define FCPP_MEMORY_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+
+/**
+ * @brief Namespace containing all the objects in the FCPP library.
+ */
+namespace fcpp {
+
+
+//! @brief Namespace for memory accounting.
+namespace memory {
+
+
+//! @brief Implementation details.
+namespace details {
+    //! @brief Bytes currently allocated in a category.
+    template <typename C>
+    inline std::atomic<int64_t> live{0};
+
+    //! @brief Maximum number of bytes allocated at the same time in a category.
+    template <typename C>
+    inline std::atomic<int64_t> peak{0};
+}
+
+
+//! @brief Bytes currently allocated in a category.
+template <typename C>
+int64_t live() {
+    return details::live<C>.load(std::memory_order_relaxed);
+}
+
+//! @brief Maximum number of bytes allocated at the same time in a category.
+template <typename C>
+int64_t peak() {
+    return details::peak<C>.load(std::memory_order_relaxed);
+}
+
+
+//! @brief Allocator accounting the bytes allocated in the category C.
+template <typename T, typename C>
+struct allocator {
+    //! @brief The type of allocated values.
+    using value_type = T;
+
+    //! @brief Default constructor.
+    allocator() = default;
+
+    //! @brief Conversion from allocators of other types.
+    template <typename U>
+    allocator(allocator<U, C> const&) {}
+
+    //! @brief Allocates n values.
+    T* allocate(size_t n) {
+        int64_t b = n * sizeof(T);
+        int64_t l = details::live<C>.fetch_add(b, std::memory_order_relaxed) + b;
+        int64_t p = details::peak<C>.load(std::memory_order_relaxed);
+        while (l > p and not details::peak<C>.compare_exchange_weak(p, l, std::memory_order_relaxed));
+        return std::allocator<T>().allocate(n);
+    }
+
+    //! @brief Deallocates n values.
+    void deallocate(T* p, size_t n) {
+        details::live<C>.fetch_sub(n * sizeof(T), std::memory_order_relaxed);
+        std::allocator<T>().deallocate(p, n);
+    }
+
+    //! @brief Allocators are stateless, hence all equal.
+    template <typename U>
+    bool operator==(allocator<U, C> const&) const {
+        return true;
+    }
+
+    //! @brief Allocators are stateless, hence all equal.
+    template <typename U>
+    bool operator!=(allocator<U, C> const&) const {
+        return false;
+    }
+};
+
+
+//! @brief Estimated heap memory owned by a value (none unless overloaded).
+template <typename T>
+size_t footprint(T const&) {
+    return 0;
+}
+
+//! @brief Estimated heap memory owned by a string (none if stored inline).
+template <typename C, typename T, typename A>
+size_t footprint(std::basic_string<C, T, A> const& s) {
+    return s.capacity() > std::basic_string<C, T, A>().capacity() ? (s.capacity() + 1) * sizeof(C) : 0;
+}
+
+//! @brief Estimated heap memory owned by a vector.
+template <typename T, typename A>
+size_t footprint(std::vector<T, A> const& v) {
+    size_t b = v.capacity() * sizeof(T);
+    for (T const& x : v) b += footprint(x);
+    return b;
+}
+
+//! @brief Estimated heap memory owned by an unordered map (buckets, and nodes with a pointer).
+template <typename K, typename T, typename H, typename E, typename A>
+size_t footprint(std::unordered_map<K, T, H, E, A> const& m) {
+    size_t b = m.bucket_count() * sizeof(void*) + m.size() * (sizeof(std::pair<K const, T>) + sizeof(void*));
+    for (auto const& x : m) b += footprint(x.first) + footprint(x.second);
+    return b;
+}
+
+
+} // namespace memory
+
+
+} // namespace fcpp
+
+
+#endif // FCPP_MEMORY_H_
@@ -0,0 +1,251 @@
+// Copyright © 2025 Giorgio Audrito. All Rights Reserved.
+
+/**
+ * @file metrics.hpp
+ * @brief Time series of simulation metrics, periodically appended to a file in line protocol.
+ *
+ * Counters are striped over cache lines and updated with relaxed atomics, so that node rounds
+ * never lock. A background thread samples them periodically, appending a line with the values
+ * and their rates per second (e.g., rounds/s) in InfluxDB line protocol.
+ */
+
+#ifndef FCPP_METRICS_H_
+#define FCPP_METRICS_H_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+/**
+ * @brief Namespace containing all the objects in the FCPP library.
+ */
+namespace fcpp {
+
+
+//! @brief Namespace for metrics.
+namespace metrics {
+
+
+class counter;
+class gauge;
+
+
+//! @brief Implementation details.
+namespace details {
+    //! @brief Number of stripes of counters.
+    constexpr size_t stripes = 16;
+
+    //! @brief The stripe used by the current thread.
+    inline size_t stripe() {
+        static std::atomic<size_t> next{0};
+        thread_local size_t s = next.fetch_add(1, std::memory_order_relaxed) % stripes;
+        return s;
+    }
+
+    //! @brief All counters and gauges (registered at construction).
+    struct registry {
+        std::mutex mutex;
+        std::vector<counter const*> counters;
+        std::vector<gauge const*> gauges;
+    };
+
+    //! @brief The global registry.
+    inline registry& metrics() {
+        static registry r;
+        return r;
+    }
+}
+
+
+//! @brief A monotonic counter.
+class counter {
+  public:
+    //! @brief Constructor, given the name of the counter (a string literal).
+    counter(char const* name) : m_name(name) {
+        details::registry& r = details::metrics();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        r.counters.push_back(this);
+    }
+
+    //! @brief Increases the counter.
+    void add(uint64_t x = 1) {
+        m_stripes[details::stripe()].value.fetch_add(x, std::memory_order_relaxed);
+    }
+
+    //! @brief The current value of the counter.
+    uint64_t value() const {
+        uint64_t v = 0;
+        for (stripe const& s : m_stripes) v += s.value.load(std::memory_order_relaxed);
+        return v;
+    }
+
+    //! @brief The name of the counter.
+    char const* name() const {
+        return m_name;
+    }
+
+  private:
+    //! @brief A part of the counter, on its own cache line.
+    struct alignas(64) stripe {
+        std::atomic<uint64_t> value{0};
+    };
+
+    //! @brief Name of the counter.
+    char const* m_name;
+    //! @brief Parts of the counter.
+    stripe m_stripes[details::stripes];
+};
+
+
+//! @brief A value that can be set.
+class gauge {
+  public:
+    //! @brief Constructor, given the name of the gauge (a string literal).
+    gauge(char const* name) : m_name(name) {
+        details::registry& r = details::metrics();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        r.gauges.push_back(this);
+    }
+
+    //! @brief Sets the value of the gauge.
+    void set(double x) {
+        m_value.store(x, std::memory_order_relaxed);
+    }
+
+    //! @brief The current value of the gauge.
+    double value() const {
+        return m_value.load(std::memory_order_relaxed);
+    }
+
+    //! @brief The name of the gauge.
+    char const* name() const {
+        return m_name;
+    }
+
+  private:
+    //! @brief Name of the gauge.
+    char const* m_name;
+    //! @brief Value of the gauge.
+    std::atomic<double> m_value{0};
+};
+
+
+//! @brief Adds the wall-clock time from construction to destruction to a counter (in nanoseconds).
+class timer {
+  public:
+    //! @brief Constructor, given the counter.
+    timer(counter& c) : m_counter(c), m_start(std::chrono::steady_clock::now()) {}
+
+    //! @brief Destructor, adding the time elapsed.
+    ~timer() {
+        m_counter.add(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_start).count());
+    }
+
+  private:
+    //! @brief The counter.
+    counter& m_counter;
+    //! @brief Start time.
+    std::chrono::steady_clock::time_point m_start;
+};
+
+
+//! @brief Appends all metrics to a file periodically, from a background thread.
+class sink {
+  public:
+    //! @brief Constructor, given the path of the file, the measurement name and the period (in seconds).
+    sink(std::string path, std::string measurement, double period = 1) :
+        m_file(path, std::ios::app), m_measurement(measurement), m_period(period) {
+        m_file.precision(10);
+        m_last = std::chrono::steady_clock::now();
+        for (counter const* c : counters()) m_previous.push_back(c->value());
+        m_thread = std::thread([this](){
+            std::unique_lock<std::mutex> lock(m_mutex);
+            while (not m_cv.wait_for(lock, std::chrono::duration<double>(m_period), [this](){ return m_stop; }))
+                flush();
+        });
+    }
+
+    //! @brief Destructor, appending the final values.
+    ~sink() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_cv.notify_one();
+        m_thread.join();
+        flush();
+    }
+
+  private:
+    //! @brief The registered counters.
+    static std::vector<counter const*> counters() {
+        details::registry& r = details::metrics();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        return r.counters;
+    }
+
+    //! @brief The registered gauges.
+    static std::vector<gauge const*> gauges() {
+        details::registry& r = details::metrics();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        return r.gauges;
+    }
+
+    //! @brief Appends a line with the current values and rates.
+    void flush() {
+        auto now = std::chrono::steady_clock::now();
+        double dt = std::chrono::duration<double>(now - m_last).count();
+        m_last = now;
+        std::vector<counter const*> cs = counters();
+        m_previous.resize(cs.size(), 0);
+        m_file << m_measurement << " ";
+        bool first = true;
+        for (size_t i = 0; i < cs.size(); ++i) {
+            uint64_t v = cs[i]->value();
+            m_file << (first ? "" : ",") << cs[i]->name() << "=" << v << "i," << cs[i]->name() << "_per_second=" << (dt > 0 ? (v - m_previous[i]) / dt : 0);
+            m_previous[i] = v;
+            first = false;
+        }
+        for (gauge const* g : gauges()) {
+            m_file << (first ? "" : ",") << g->name() << "=" << g->value();
+            first = false;
+        }
+        auto wall = std::chrono::system_clock::now().time_since_epoch();
+        m_file << " " << std::chrono::duration_cast<std::chrono::nanoseconds>(wall).count() << std::endl;
+    }
+
+    //! @brief The file where metrics are appended.
+    std::ofstream m_file;
+    //! @brief The measurement name.
+    std::string m_measurement;
+    //! @brief The period between lines (in seconds).
+    double m_period;
+    //! @brief The time of the last line.
+    std::chrono::steady_clock::time_point m_last;
+    //! @brief The counter values at the last line.
+    std::vector<uint64_t> m_previous;
+    //! @brief Whether the thread should stop.
+    bool m_stop = false;
+    //! @brief Mutex for stopping the thread.
+    std::mutex m_mutex;
+    //! @brief Condition variable for stopping the thread.
+    std::condition_variable m_cv;
+    //! @brief The background thread.
+    std::thread m_thread;
+};
+
+
+} // namespace metrics
+
+
+} // namespace fcpp
+
+
+#endif // FCPP_METRICS_H_
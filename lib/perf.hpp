@@ -0,0 +1,292 @@
+// Copyright © 2025 Giorgio Audrito. All Rights Reserved.
+
+/**
+ * @file perf.hpp
+ * @brief Hardware performance counters sampled around rounds and aggregate function calls.
+ *
+ * Counting is compiled in only if FCPP_PERF is defined. Every thread opens its own group of
+ * counters through perf_event_open, and accumulates the counts of every scope in per-thread
+ * totals, merged by name only when written. If the counters cannot be opened (e.g. outside
+ * Linux, in containers, or with a restrictive perf_event_paranoid), only calls are counted.
+ */
+
+#ifndef FCPP_PERF_H_
+#define FCPP_PERF_H_
+
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+
+/**
+ * @brief Namespace containing all the objects in the FCPP library.
+ */
+namespace fcpp {
+
+
+//! @brief Namespace for hardware performance counters.
+namespace perf {
+
+
+//! @brief Number of counters.
+constexpr size_t events = 5;
+
+//! @brief Names of the counters.
+constexpr char const* event_names[events] = {"cycles", "instructions", "L1d_misses", "LLC_misses", "branch_misses"};
+
+
+//! @brief Counts accumulated over the calls of a function.
+struct totals {
+    //! @brief Number of calls.
+    size_t calls = 0;
+    //! @brief Number of calls in which every counter was read (on threads where it is available).
+    size_t counted[events] = {};
+    //! @brief Sum of the counts of every counter.
+    uint64_t counts[events] = {};
+
+    //! @brief Combines totals.
+    totals& operator+=(totals const& o) {
+        calls += o.calls;
+        for (size_t i = 0; i < events; ++i) {
+            counted[i] += o.counted[i];
+            counts[i] += o.counts[i];
+        }
+        return *this;
+    }
+
+    //! @brief Average count of a counter per call in which it was read (negative if it was never read).
+    double average(size_t i) const {
+        return counted[i] ? counts[i] / double(counted[i]) : -1;
+    }
+};
+
+
+//! @brief A group of counters for the current thread.
+class counters {
+  public:
+    //! @brief Opens the counters (the unavailable ones are skipped).
+    counters() {
+        for (size_t i = 0; i < events; ++i) m_slot[i] = -1;
+#ifdef __linux__
+        constexpr uint64_t l1d_read_miss = PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        uint32_t types[events] = {PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HW_CACHE, PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE};
+        uint64_t configs[events] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, l1d_read_miss, PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+        for (size_t i = 0; i < events; ++i) {
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = types[i];
+            attr.config = configs[i];
+            attr.disabled = m_leader < 0;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_GROUP;
+            int fd = syscall(SYS_perf_event_open, &attr, 0, -1, m_leader, 0);
+            if (fd < 0) continue;
+            if (m_leader < 0) m_leader = fd;
+            m_fds.push_back(fd);
+            m_slot[i] = m_fds.size() - 1;
+        }
+        if (m_leader >= 0) ioctl(m_leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+    }
+
+    //! @brief Closes the counters.
+    ~counters() {
+#ifdef __linux__
+        for (int fd : m_fds) close(fd);
+#endif
+    }
+
+    //! @brief Whether any counter is available.
+    bool available() const {
+        return m_leader >= 0;
+    }
+
+    //! @brief Whether a given counter is available.
+    bool available(size_t i) const {
+        return m_slot[i] >= 0;
+    }
+
+    //! @brief Reads the current counts (zero for unavailable counters), returning whether it succeeded.
+    bool read(uint64_t* v) const {
+#ifdef __linux__
+        uint64_t buf[events + 1];
+        if (m_leader < 0 or ::read(m_leader, buf, sizeof(buf)) < ssize_t(sizeof(uint64_t) * (m_fds.size() + 1))) return false;
+        for (size_t i = 0; i < events; ++i) v[i] = m_slot[i] < 0 ? 0 : buf[m_slot[i] + 1];
+        return true;
+#else
+        return false;
+#endif
+    }
+
+  private:
+    //! @brief The file descriptor of the group leader (negative if none).
+    int m_leader = -1;
+    //! @brief The file descriptors of the open counters.
+    std::vector<int> m_fds;
+    //! @brief The position of every counter in the group (negative if unavailable).
+    int m_slot[events];
+};
+
+
+//! @brief Implementation details.
+namespace details {
+    //! @brief Totals of a thread for every function name.
+    using table = std::unordered_map<char const*, totals>;
+
+    //! @brief All tables, and those not currently owned by a thread.
+    struct registry {
+        std::mutex mutex;
+        std::vector<std::unique_ptr<table>> tables;
+        std::vector<table*> free;
+        bool any_available = false;
+    };
+
+    //! @brief The global registry.
+    inline registry& tables() {
+        static registry r;
+        return r;
+    }
+
+    //! @brief The counters and the table of a thread, giving the table back when the thread exits.
+    struct owner {
+        owner() {
+            registry& r = tables();
+            std::lock_guard<std::mutex> lock(r.mutex);
+            if (r.free.empty()) {
+                r.tables.emplace_back(new table());
+                current = r.tables.back().get();
+            } else {
+                current = r.free.back();
+                r.free.pop_back();
+            }
+            r.any_available |= counts.available();
+        }
+        ~owner() {
+            registry& r = tables();
+            std::lock_guard<std::mutex> lock(r.mutex);
+            r.free.push_back(current);
+        }
+        counters counts;
+        table* current;
+    };
+
+    //! @brief The counters and table of the current thread.
+    inline owner& local() {
+        thread_local owner o;
+        return o;
+    }
+}
+
+
+//! @brief Counts events from construction to destruction, adding them to the totals of a function.
+class scope {
+  public:
+    //! @brief Constructor, given the name of the function (a string literal).
+    scope(char const* name) : m_name(name), m_owner(details::local()) {
+        m_ok = m_owner.counts.read(m_start);
+    }
+
+    //! @brief Destructor, adding the counts to the totals.
+    ~scope() {
+        totals& t = (*m_owner.current)[m_name];
+        ++t.calls;
+        uint64_t end[events];
+        if (m_ok and m_owner.counts.read(end))
+            for (size_t i = 0; i < events; ++i)
+                if (m_owner.counts.available(i)) {
+                    ++t.counted[i];
+                    t.counts[i] += end[i] - m_start[i];
+                }
+    }
+
+  private:
+    //! @brief Name of the function.
+    char const* m_name;
+    //! @brief Counters and table of the thread.
+    details::owner& m_owner;
+    //! @brief Whether the starting counts were read.
+    bool m_ok;
+    //! @brief Starting counts.
+    uint64_t m_start[events];
+};
+
+
+//! @brief Totals for every function so far, merged across threads (call while no scope is active).
+inline std::map<std::string, totals> summary() {
+    details::registry& r = details::tables();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    std::map<std::string, totals> s;
+    for (auto const& t : r.tables)
+        for (auto const& x : *t)
+            s[x.first] += x.second;
+    return s;
+}
+
+//! @brief Clears the totals of every function (call while no scope is active).
+inline void reset() {
+    details::registry& r = details::tables();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    for (auto const& t : r.tables) t->clear();
+}
+
+//! @brief Writes the average counts per call of every function as a table (over the calls in which each counter was read).
+inline void write(std::ostream& o) {
+    details::registry& r = details::tables();
+    if (not r.any_available) o << "hardware counters unavailable (check /proc/sys/kernel/perf_event_paranoid), only calls are counted\n";
+    o << "function calls";
+    for (size_t i = 0; i < events; ++i) o << " " << event_names[i];
+    o << " IPC\n";
+    for (auto const& x : summary()) {
+        totals const& t = x.second;
+        o << x.first << " " << t.calls;
+        for (size_t i = 0; i < events; ++i) {
+            if (t.counted[i]) o << " " << t.average(i);
+            else o << " n/a";
+        }
+        if (t.counted[0] and t.counted[1] and t.counts[0] > 0) o << " " << t.average(1) / t.average(0);
+        else o << " n/a";
+        o << "\n";
+    }
+}
+
+//! @brief Writes the average counts per call of every function as a JSON object (null for counters never read).
+inline void write_json(std::ostream& o) {
+    o << "{";
+    bool first = true;
+    for (auto const& x : summary()) {
+        totals const& t = x.second;
+        o << (first ? "" : ", ") << "\"" << x.first << "\": {\"calls\": " << t.calls;
+        for (size_t i = 0; i < events; ++i) {
+            o << ", \"" << event_names[i] << "\": ";
+            if (t.counted[i]) o << t.average(i);
+            else o << "null";
+        }
+        o << "}";
+        first = false;
+    }
+    o << "}";
+}
+
+
+} // namespace perf
+
+
+} // namespace fcpp
+
+
+#endif // FCPP_PERF_H_
@@ -0,0 +1,99 @@
+// Copyright © 2025 Giorgio Audrito. All Rights Reserved.
+
+/**
+ * @file runtime.hpp
+ * @brief Distributions and connectors whose parameters are read from the network parameters.
+ *
+ * They complement the `_n` variants in FCPP, whose parameters are template arguments, so that
+ * scenarios can be changed at run time without recompiling the whole component stack.
+ */
+
+#ifndef FCPP_RUNTIME_H_
+#define FCPP_RUNTIME_H_
+
+#include <random>
+
+//! Importing the FCPP library.
+#include "lib/fcpp.hpp"
+
+
+/**
+ * @brief Namespace containing all the objects in the FCPP library.
+ */
+namespace fcpp {
+
+
+//! @brief Namespace for random distributions.
+namespace distribution {
+
+
+//! @brief Uniform distribution of points in the cube [0,side]^n, with side read from the `side_tag` network parameter.
+template <typename side_tag, size_t n = 2>
+class cube_i {
+  public:
+    //! @brief The type of the generated points.
+    using type = vec<n>;
+
+    //! @brief Constructor, given a generator and the network parameters.
+    template <typename G, typename S, typename T>
+    cube_i(G&&, common::tagged_tuple<S,T> const& t) : m_dist(0, common::get<side_tag>(t)) {}
+
+    //! @brief Generates a point.
+    template <typename G>
+    type operator()(G&& g) {
+        type v;
+        for (size_t i = 0; i < n; ++i) v[i] = m_dist(g);
+        return v;
+    }
+
+  private:
+    //! @brief The distribution of every coordinate.
+    std::uniform_real_distribution<real_t> m_dist;
+};
+
+
+} // namespace distribution
+
+
+//! @brief Namespace for connection predicates.
+namespace connect {
+
+
+//! @brief Connection within a fixed radius, read from the `radius_tag` network parameter.
+template <typename radius_tag, size_t n = 2>
+class fixed_i {
+  public:
+    //! @brief Type for data associated to connection.
+    using data_type = common::tagged_tuple_t<>;
+
+    //! @brief Type for positions.
+    using position_type = vec<n>;
+
+    //! @brief Constructor, given a generator and the network parameters.
+    template <typename G, typename S, typename T>
+    fixed_i(G&&, common::tagged_tuple<S,T> const& t) : m_radius(common::get<radius_tag>(t)) {}
+
+    //! @brief The maximum radius of connection.
+    real_t maximum_radius() const {
+        return m_radius;
+    }
+
+    //! @brief Checks whether two devices are connected.
+    template <typename G>
+    bool operator()(G&&, data_type const&, position_type const& position1, data_type const&, position_type const& position2) const {
+        return norm(position1 - position2) <= m_radius;
+    }
+
+  private:
+    //! @brief The radius of connection.
+    real_t m_radius;
+};
+
+
+} // namespace connect
+
+
+} // namespace fcpp
+
+
+#endif // FCPP_RUNTIME_H_
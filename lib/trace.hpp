@@ -0,0 +1,256 @@
+// Copyright © 2025 Giorgio Audrito. All Rights Reserved.
+
+/**
+ * @file trace.hpp
+ * @brief Tracing of node rounds, messages and aggregate function calls in Chrome trace format.
+ *
+ * Tracing is compiled in only if FCPP_TRACE is defined. Events are recorded in per-thread rings
+ * (overwriting the oldest events when full) without locks, and written as JSON at the end, for
+ * chrome://tracing or Perfetto. Every node has its own track, with spans placed at the simulated
+ * time of the round and lasting the wall-clock time of the computation, and messages as flows.
+ * Only events within a window of simulated time are recorded, so that rings can hold the whole
+ * window of interest (e.g., the convergence after a source switch).
+ */
+
+#ifndef FCPP_TRACE_H_
+#define FCPP_TRACE_H_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+//! Importing the FCPP library.
+#include "lib/fcpp.hpp"
+#include "lib/perf.hpp"
+
+
+//! @brief Records a trace span named `name` until the end of the current scope.
+#ifdef FCPP_TRACE
+#define FCPP_TRACE_SPAN(name) fcpp::trace::span trace_span_(node, name);
+#else
+#define FCPP_TRACE_SPAN(name)
+#endif
+
+//! @brief Counts hardware events for `name` until the end of the current scope.
+#ifdef FCPP_PERF
+#define FCPP_PERF_SPAN(name) fcpp::perf::scope perf_scope_(name);
+#else
+#define FCPP_PERF_SPAN(name)
+#endif
+
+//! @brief Instruments the rest of the current scope as `name`, in functions with a `node` argument.
+#define FCPP_SPAN(name) FCPP_TRACE_SPAN(name) FCPP_PERF_SPAN(name)
+
+
+/**
+ * @brief Namespace containing all the objects in the FCPP library.
+ */
+namespace fcpp {
+
+
+//! @brief Namespace for tracing.
+namespace trace {
+
+
+//! @brief A trace event.
+struct event {
+    //! @brief Name of the event (a string literal).
+    char const* name;
+    //! @brief Phase of the event ('X' for spans, 's' and 'f' for start and end of flows).
+    char phase;
+    //! @brief Track of the event (the node).
+    device_t track;
+    //! @brief Simulated time of the event (in seconds).
+    times_t time;
+    //! @brief Wall-clock duration of spans (in microseconds).
+    double duration;
+    //! @brief Identifier of flows.
+    uint64_t id;
+};
+
+
+//! @brief Ring buffer of events, written by a single thread.
+class ring {
+  public:
+    //! @brief Number of events kept.
+    static constexpr size_t capacity = 1 << 18;
+
+    //! @brief Constructor, given an index distinguishing rings.
+    ring(uint64_t index) : m_events(capacity), m_index(index) {}
+
+    //! @brief Adds an event.
+    void push(event const& e) {
+        size_t i = m_count.load(std::memory_order_relaxed);
+        m_events[i % capacity] = e;
+        m_count.store(i + 1, std::memory_order_release);
+    }
+
+    //! @brief Returns a new identifier for flows, unique across rings.
+    uint64_t next_id() {
+        return (m_index << 40) | m_ids++;
+    }
+
+    //! @brief Calls a function on every event kept, from the oldest.
+    template <typename F>
+    void for_each(F&& f) const {
+        size_t n = m_count.load(std::memory_order_acquire);
+        for (size_t i = n > capacity ? n - capacity : 0; i < n; ++i)
+            f(m_events[i % capacity]);
+    }
+
+  private:
+    //! @brief The events.
+    std::vector<event> m_events;
+    //! @brief The number of events pushed so far.
+    std::atomic<size_t> m_count{0};
+    //! @brief The index of the ring.
+    uint64_t m_index;
+    //! @brief The number of flow identifiers produced.
+    uint64_t m_ids = 0;
+};
+
+
+//! @brief Implementation details.
+namespace details {
+    //! @brief All rings, and those not currently owned by a thread.
+    struct registry {
+        std::mutex mutex;
+        std::vector<std::unique_ptr<ring>> rings;
+        std::vector<ring*> free;
+    };
+
+    //! @brief The global registry.
+    inline registry& rings() {
+        static registry r;
+        return r;
+    }
+
+    //! @brief Start of the window of simulated time recorded.
+    inline std::atomic<times_t> window_start{0};
+
+    //! @brief End of the window of simulated time recorded.
+    inline std::atomic<times_t> window_end{INF};
+
+    //! @brief Ownership of a ring by a thread, giving it back when the thread exits.
+    struct owner {
+        owner() {
+            registry& r = rings();
+            std::lock_guard<std::mutex> lock(r.mutex);
+            if (r.free.empty()) {
+                r.rings.emplace_back(new ring(r.rings.size()));
+                current = r.rings.back().get();
+            } else {
+                current = r.free.back();
+                r.free.pop_back();
+            }
+        }
+        ~owner() {
+            registry& r = rings();
+            std::lock_guard<std::mutex> lock(r.mutex);
+            r.free.push_back(current);
+        }
+        ring* current;
+    };
+}
+
+//! @brief The ring of the current thread.
+inline ring& local() {
+    thread_local details::owner o;
+    return *o.current;
+}
+
+
+//! @brief Sets the window of simulated time in which events are recorded (the whole simulation by default).
+inline void window(times_t start, times_t end) {
+    details::window_start.store(start, std::memory_order_relaxed);
+    details::window_end.store(end, std::memory_order_relaxed);
+}
+
+//! @brief Whether events at a given simulated time are recorded.
+inline bool recording(times_t t) {
+    return details::window_start.load(std::memory_order_relaxed) <= t and t <= details::window_end.load(std::memory_order_relaxed);
+}
+
+
+//! @brief Records a span from construction to destruction.
+class span {
+  public:
+    //! @brief Constructor, given the node and the name of the span.
+    template <typename node_t>
+    span(node_t const& node, char const* name) :
+        m_name(name), m_track(node.uid), m_time(node.current_time()), m_start(std::chrono::steady_clock::now()) {}
+
+    //! @brief Destructor, recording the span (if within the window).
+    ~span() {
+        if (not recording(m_time)) return;
+        double d = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - m_start).count();
+        local().push({m_name, 'X', m_track, m_time, d, 0});
+    }
+
+  private:
+    //! @brief Name of the span.
+    char const* m_name;
+    //! @brief Track of the span.
+    device_t m_track;
+    //! @brief Simulated start time.
+    times_t m_time;
+    //! @brief Wall-clock start time.
+    std::chrono::steady_clock::time_point m_start;
+};
+
+
+//! @brief Records a message from a device at a given time, received by a node in its current round.
+template <typename node_t>
+void message(node_t const& node, device_t from, times_t sent) {
+    ring& r = local();
+    uint64_t id = r.next_id();
+    r.push({"message", 's', from, sent, 0, id});
+    r.push({"message", 'f', node.uid, node.current_time(), 0, id});
+}
+
+
+//! @brief Records the messages from all neighbours received by a node since its previous round (if within the window).
+template <typename node_t>
+void messages(node_t const& node) {
+    if (not recording(node.current_time())) return;
+    // retained messages already received in a previous round are skipped
+    map_hood([&](device_t d, times_t lag){
+        times_t sent = node.current_time() - lag;
+        if (d != node.uid and sent > node.previous_time()) message(node, d, sent);
+        return 0;
+    }, node.nbr_uid(), node.nbr_lag());
+}
+
+
+//! @brief Writes all events kept in Chrome trace JSON format.
+inline void write(std::ostream& o) {
+    details::registry& r = details::rings();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    std::ios_base::fmtflags flags = o.flags();
+    o << std::fixed << std::setprecision(3) << "{\"traceEvents\": [\n";
+    bool first = true;
+    for (auto const& q : r.rings)
+        q->for_each([&](event const& e){
+            o << (first ? "" : ",\n") << "{\"name\": \"" << e.name << "\", \"ph\": \"" << e.phase << "\", \"pid\": 0, \"tid\": " << e.track << ", \"ts\": " << e.time * 1e6;
+            if (e.phase == 'X') o << ", \"dur\": " << e.duration;
+            else o << ", \"cat\": \"message\", \"id\": " << e.id << (e.phase == 'f' ? ", \"bp\": \"e\"" : "");
+            o << "}";
+            first = false;
+        });
+    o << "\n], \"displayTimeUnit\": \"ms\"}\n";
+    o.flags(flags);
+}
+
+
+} // namespace trace
+
+
+} // namespace fcpp
+
+
+#endif // FCPP_TRACE_H_
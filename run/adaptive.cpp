@@ -0,0 +1,108 @@
+// Copyright © 2025 Giorgio Audrito. All Rights Reserved.
+
+/**
+ * @file adaptive.cpp
+ * @brief Comparison of convergence times and total work with fixed and adaptive rounds.
+ *
+ * The convergence time after a source switch is the last time within the following period at which
+ * nodes disagree on the diameter (the minimum and maximum diameters differ), measured after the switch.
+ * The total work is the number of rounds performed by all nodes, read every simulated second.
+ */
+
+#include <algorithm>
+#include <vector>
+
+//! @brief Nothing is rendered in this executable.
+#define FCPP_CASE_STUDY_RENDER 0
+
+#include "lib/case_study.hpp"
+#include "lib/checkpoint.hpp"
+
+/**
+ * @brief Namespace containing all the objects in the FCPP library.
+ */
+namespace fcpp {
+
+//! @brief Number of seeds for fixed and adaptive rounds.
+constexpr size_t seed_num = 10;
+
+/**
+ * @brief Runs a network with a given seed, recording the convergence times after every switch and the total work.
+ *
+ * The rounds of every node are read every simulated second, so that those of a former source
+ * performed in its last second before being removed are not counted.
+ */
+template <typename net_t>
+void simulate(option::plot_t& p, size_t seed, bool adaptive, times_t* hop_last, times_t* stable_last, size_t& work) {
+    std::string output = "output/raw/adaptive_seed-" + std::to_string(seed) + "_adaptive-" + std::to_string(adaptive) + ".txt";
+    // The initialisation values (seed, log file, plotter object, no degree bound and whether rounds are adaptive).
+    auto init_v = common::make_tagged_tuple<option::seed, option::output, option::plotter, option::degree, option::adaptive>(seed, output, &p, 0, adaptive);
+    // Construct the network object.
+    net_t network{init_v};
+    // Rounds performed by every node, as of its latest reading.
+    std::vector<size_t> rounds(node_num);
+    // Step the network every simulated second, recording the last disagreement after every switch.
+    for (size_t t = 1; t <= end_time; ++t) {
+        run_until(network, t);
+        size_t s = std::min<size_t>(t / conv_time, source_num - 1);
+        if (not agreement<coordination::tags::hop_diam>(network, node_num)) hop_last[s] = t - s * conv_time;
+        if (not agreement<coordination::tags::stable_diam>(network, node_num)) stable_last[s] = t - s * conv_time;
+        for (device_t uid = 0; uid < node_num; ++uid)
+            if (network.node_count(uid))
+                rounds[uid] = network.node_at(uid).storage(coordination::tags::rounds{});
+    }
+    // Run the simulation until exit.
+    network.run();
+    work = 0;
+    for (size_t r : rounds) work += r;
+}
+
+} // namespace fcpp
+
+
+//! @brief The main function.
+int main() {
+    using namespace fcpp;
+
+    // The plotter object (unused, since both kinds of rounds share the same degree bound).
+    option::plot_t p;
+    // The network object types (batch simulators with fixed and adaptive rounds).
+    using fixed_net_t = component::batch_simulator<option::list>::net;
+    using adaptive_net_t = component::batch_simulator<option::adaptive_list>::net;
+    // Convergence times after every switch, for fixed and adaptive rounds and every seed, of hop_diameter and stable_diameter.
+    std::vector<times_t> hop_conv(2 * seed_num * source_num);
+    std::vector<times_t> stable_conv(hop_conv.size());
+    // Total work for fixed and adaptive rounds and every seed.
+    std::vector<size_t> work(2 * seed_num);
+    for (size_t a = 0; a < 2; ++a)
+        for (size_t seed = 0; seed < seed_num; ++seed) {
+            size_t i = a * seed_num + seed;
+            if (a) simulate<adaptive_net_t>(p, seed, true, &hop_conv[i * source_num], &stable_conv[i * source_num], work[i]);
+            else simulate<fixed_net_t>(p, seed, false, &hop_conv[i * source_num], &stable_conv[i * source_num], work[i]);
+        }
+    // Print mean and maximum convergence times over seeds after every switch, and the mean total work.
+    auto print = [](std::string name, std::vector<times_t> const& conv){
+        for (size_t a = 0; a < 2; ++a) {
+            std::cout << name << " (" << (a ? "adaptive" : "fixed") << " rounds):";
+            for (size_t s = 0; s < source_num; ++s) {
+                times_t sum = 0, max = 0;
+                for (size_t seed = 0; seed < seed_num; ++seed) {
+                    times_t c = conv[(a * seed_num + seed) * source_num + s];
+                    sum += c;
+                    max = std::max(max, c);
+                }
+                std::cout << " source " << s << " mean " << sum / seed_num << " max " << max << (s + 1 < source_num ? ";" : "\n");
+            }
+        }
+    };
+    std::cout << "convergence times after the switch to every source (in simulated seconds):\n";
+    print("hop_diameter", hop_conv);
+    print("stable_diameter", stable_conv);
+    std::cout << "total rounds performed (mean over seeds):\n";
+    for (size_t a = 0; a < 2; ++a) {
+        size_t sum = 0;
+        for (size_t seed = 0; seed < seed_num; ++seed) sum += work[a * seed_num + seed];
+        std::cout << (a ? "adaptive" : "fixed") << " rounds: " << sum / real_t(seed_num) << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,246 @@
+// Copyright © 2025 Giorgio Audrito. All Rights Reserved.
+
+/**
+ * @file benchmark.cpp
+ * @brief Microbenchmarks of every function in Table 1 and of the case studies, run alone on standard topologies.
+ *
+ * Prints one JSON object per line and run, with time per node-round, bytes per message and convergence time
+ * (and hardware counters per function call, if FCPP_PERF is defined).
+ */
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <string>
+
+#include <random>
+
+#include "lib/examples.hpp"
+
+/**
+ * @brief Namespace containing all the objects in the FCPP library.
+ */
+namespace fcpp {
+
+//! @brief The maximum communication range between nodes.
+constexpr size_t comm_range = 100;
+//! @brief Distance between consecutive nodes in grid and line topologies.
+constexpr real_t spacing = 70;
+//! @brief Expected number of neighbours in random topologies.
+constexpr real_t density = 10;
+//! @brief Dimensionality of the space.
+constexpr size_t dim = 2;
+//! @brief End of every simulation.
+constexpr size_t end_time = 100;
+//! @brief Time after which old values are discarded.
+constexpr times_t discard_time = 10;
+//! @brief Number of repetitions of every run (with different seeds).
+constexpr size_t repetitions = 5;
+
+//! @brief Names of the functions benchmarked.
+constexpr char const* functions[] = {"lowpass", "integrate", "accumulate", "rdist", "maximize", "maxgossip", "dist", "election", "closereach", "minintegral", "sharedcount", "hop_diameter", "stable_diameter"};
+//! @brief Names of the topologies.
+constexpr char const* topologies[] = {"grid", "random", "line"};
+//! @brief Numbers of nodes.
+constexpr size_t sizes[] = {100, 1000, 10000};
+
+
+//! @brief Namespace containing the libraries of coordination routines.
+namespace coordination {
+
+//! @brief Tags used in the node storage.
+namespace tags {
+    //! @brief Index of the function to be run.
+    struct function_id {};
+    //! @brief Index of the topology.
+    struct topology_id {};
+    //! @brief Number of nodes in the network.
+    struct node_count {};
+    //! @brief Value computed by the function.
+    struct value {};
+    //! @brief Time of the last change of the value.
+    struct last_change {};
+    //! @brief Number of rounds performed.
+    struct rounds {};
+    //! @brief Total size of messages sent.
+    struct bytes {};
+}
+
+//! @brief Main function.
+MAIN() {
+    // import tag names in the local scope.
+    using namespace tags;
+
+    // run the chosen function alone, with simple inputs
+    bool source = node.uid == 0;
+    real_t v = node.uid % 10;
+    real_t r = 0;
+    switch (node.storage(function_id{})) {
+        case 0:  r = lowpass(CALL, v); break;
+        case 1:  r = integrate(CALL, v); break;
+        case 2:  r = accumulate(CALL, v); break;
+        case 3:  r = rdist(CALL, source); break;
+        case 4:  r = maximize(CALL, v, discard_time); break;
+        case 5:  r = maxgossip(CALL, v); break;
+        case 6:  r = dist(CALL, source); break;
+        case 7:  r = election(CALL); break;
+        case 8:  r = closereach(CALL, node.uid % 3 != 0, source); break;
+        case 9:  r = minintegral(CALL, v); break;
+        case 10: r = sharedcount(CALL); break;
+        case 11: r = get<2>(hop_diameter(CALL, discard_time)); break;
+        default: r = get<2>(stable_diameter(CALL, source)); break;
+    }
+
+    // record measures
+    if (r != node.storage(value{})) node.storage(last_change{}) = node.current_time();
+    node.storage(value{}) = r;
+    node.storage(rounds{}) += 1;
+    node.storage(bytes{}) += node.msg_size();
+}
+//! @brief Export types used by the main function (update it when expanding the program).
+FUN_EXPORT main_t = export_list<lowpass_t, integrate_t, accumulate_t, rdist_t, maximize_t, maxgossip_t, dist_t, election_t, closereach_t, minintegral_t, sharedcounter_t, hop_diameter_t, stable_diameter_t>;
+
+} // namespace coordination
+
+
+//! @brief Namespace for random distributions.
+namespace distribution {
+
+//! @brief Positions of nodes in the topology read from the network parameters, the i-th node spawned being placed i-th.
+class topology_d {
+  public:
+    //! @brief The type of the generated points.
+    using type = vec<dim>;
+
+    //! @brief Constructor, given a generator and the network parameters.
+    template <typename G, typename S, typename T>
+    topology_d(G&&, common::tagged_tuple<S,T> const& t) :
+        m_topology(common::get<coordination::tags::topology_id>(t)),
+        m_width(std::ceil(std::sqrt(common::get<coordination::tags::node_count>(t)))),
+        m_dist(0, comm_range * std::sqrt(common::get<coordination::tags::node_count>(t) * M_PI / density)) {}
+
+    //! @brief Generates the position of the next node.
+    template <typename G>
+    type operator()(G&& g) {
+        size_t i = m_next++;
+        switch (m_topology) {
+            case 0:  return {real_t(i % m_width) * spacing, real_t(i / m_width) * spacing};
+            case 1:  return {m_dist(g), m_dist(g)};
+            default: return {i * spacing, 0};
+        }
+    }
+
+  private:
+    //! @brief The topology.
+    size_t m_topology;
+    //! @brief The number of nodes per row in grids.
+    size_t m_width;
+    //! @brief The number of nodes placed so far.
+    size_t m_next = 0;
+    //! @brief The distribution of every coordinate in random topologies (in a square keeping the density constant).
+    std::uniform_real_distribution<real_t> m_dist;
+};
+
+} // namespace distribution
+
+
+// SYSTEM SETUP
+
+//! @brief Namespace for component options.
+namespace option {
+
+//! @brief Import tags to be used for component options.
+using namespace component::tags;
+//! @brief Import tags used by aggregate functions.
+using namespace coordination::tags;
+
+//! @brief Description of the round schedule.
+using round_s = sequence::periodic<
+    distribution::interval_n<times_t, 0, 1>,      // uniform time in the [0,1] interval for start
+    distribution::weibull_n<times_t, 10, 1, 10>,  // weibull-distributed time for interval (10/10=1 mean, 1/10=0.1 deviation)
+    distribution::constant_n<times_t, end_time>   // the constant end_time number for end
+>;
+//! @brief The sequence of node generation events (node_count devices all generated at time 0).
+using spawn_s = sequence::multiple<distribution::constant_i<size_t, node_count>, distribution::constant_n<times_t, 0>>;
+//! @brief The contents of the node storage as tags and associated types.
+using store_t = tuple_store<
+    function_id,                size_t,
+    topology_id,                size_t,
+    node_count,                 size_t,
+    value,                      real_t,
+    last_change,                times_t,
+    rounds,                     size_t,
+    bytes,                      size_t,
+    debug,                      std::string
+>;
+
+//! @brief The general simulation options.
+DECLARE_OPTIONS(list,
+    parallel<false>,     // single-threaded, for stable timings
+    synchronised<false>, // optimise for asynchronous networks
+    program<coordination::main>,   // program to be run (refers to MAIN above)
+    exports<coordination::main_t>, // export type list (types used in messages)
+    retain<metric::retain<3,1>>,   // messages are kept for 3 seconds before expiring
+    message_size<true>,      // the size of messages is computed
+    round_schedule<round_s>, // the sequence generator for round events on nodes
+    spawn_schedule<spawn_s>, // the sequence generator of node creation events on the network
+    store_t,       // the contents of the node storage
+    init<
+        x,           distribution::topology_d, // nodes are placed in their topology as they are spawned
+        function_id, distribution::constant_i<size_t, function_id>, // the function is read from the network parameters
+        topology_id, distribution::constant_i<size_t, topology_id>, // the topology is read from the network parameters
+        node_count,  distribution::constant_i<size_t, node_count>   // the number of nodes is read from the network parameters
+    >,
+    dimension<dim>, // dimensionality of the space
+    connector<connect::fixed<comm_range, 1, dim>> // connection allowed within a fixed comm range
+);
+
+} // namespace option
+
+} // namespace fcpp
+
+
+//! @brief The main function.
+int main() {
+    using namespace fcpp;
+    using namespace coordination::tags;
+
+    // The network object type (batch simulator with given options).
+    using net_t = component::batch_simulator<option::list>::net;
+    // The stream where logs are discarded.
+    std::ostream null_stream(nullptr);
+    for (size_t f = 0; f < std::size(functions); ++f)
+        for (size_t t = 0; t < std::size(topologies); ++t)
+            for (size_t n : sizes)
+                for (size_t rep = 0; rep < repetitions; ++rep) {
+                    // The initialisation values (simulation name, log stream, seed, function, topology and number of nodes).
+                    auto init_v = common::make_tagged_tuple<option::name, option::output, option::seed, function_id, topology_id, node_count>("Benchmark", &null_stream, rep, f, t, n);
+                    // Construct the network object.
+                    net_t network{init_v};
+#ifdef FCPP_PERF
+                    perf::reset();
+#endif
+                    // Run the simulation until exit, measuring time.
+                    auto start = std::chrono::steady_clock::now();
+                    network.run();
+                    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+                    // Collect the results.
+                    size_t rounds_sum = 0, bytes_sum = 0;
+                    times_t conv = 0;
+                    for (device_t uid = 0; uid < n; ++uid) {
+                        auto& d = network.node_at(uid);
+                        rounds_sum += d.storage(rounds{});
+                        bytes_sum += d.storage(bytes{});
+                        conv = std::max(conv, d.storage(last_change{}));
+                    }
+                    std::cout << "{\"function\": \"" << functions[f] << "\", \"topology\": \"" << topologies[t] << "\", \"nodes\": " << n << ", \"repetition\": " << rep
+                              << ", \"ns_per_round_node\": " << ns / rounds_sum << ", \"bytes_per_message\": " << bytes_sum / real_t(rounds_sum)
+                              << ", \"convergence_time\": " << conv << ", \"converged\": " << (conv < end_time - 10 ? "true" : "false");
+#ifdef FCPP_PERF
+                    std::cout << ", \"perf\": ";
+                    perf::write_json(std::cout);
+#endif
+                    std::cout << "}" << std::endl;
+                }
+    return 0;
+}
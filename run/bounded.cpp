@@ -0,0 +1,91 @@
+// Copyright © 2025 Giorgio Audrito. All Rights Reserved.
+
+/**
+ * @file bounded.cpp
+ * @brief Comparison of convergence times with bounded and unbounded degree.
+ *
+ * The convergence time after a source switch is the last time within the following period at which
+ * nodes disagree on the diameter (the minimum and maximum diameters differ), measured after the switch.
+ */
+
+#include <algorithm>
+#include <vector>
+
+//! @brief Nothing is rendered in this executable.
+#define FCPP_CASE_STUDY_RENDER 0
+
+#include "lib/case_study.hpp"
+#include "lib/checkpoint.hpp"
+
+/**
+ * @brief Namespace containing all the objects in the FCPP library.
+ */
+namespace fcpp {
+
+//! @brief Degree bounds to be compared (0 meaning unbounded).
+constexpr size_t degrees[] = {0, 4, 8, 16};
+//! @brief Number of seeds for every degree bound.
+constexpr size_t seed_num = 10;
+
+} // namespace fcpp
+
+
+//! @brief The main function.
+int main() {
+    using namespace fcpp;
+    using namespace coordination::tags;
+
+    // The plotter object.
+    option::plot_t p;
+    std::cout << "/*\n";
+#ifdef FCPP_METRICS
+    // The sink appending metrics every second.
+    metrics::sink metrics_sink("output/metrics.lp", "bounded");
+#endif
+    // The network object type (batch simulator with given options).
+    using net_t = component::batch_simulator<option::list>::net;
+    // Convergence times after every switch, for every degree bound and seed, of hop_diameter and stable_diameter.
+    std::vector<times_t> hop_conv(std::size(degrees) * seed_num * source_num);
+    std::vector<times_t> stable_conv(hop_conv.size());
+    for (size_t d = 0; d < std::size(degrees); ++d)
+        for (size_t seed = 0; seed < seed_num; ++seed) {
+            std::string output = "output/raw/bounded_seed-" + std::to_string(seed) + "_degree-" + std::to_string(degrees[d]) + ".txt";
+            // The initialisation values (seed, log file, plotter object, degree bound and fixed rounds).
+            auto init_v = common::make_tagged_tuple<option::seed, option::output, option::plotter, option::degree, option::adaptive>(seed, output, &p, degrees[d], false);
+            // Construct the network object.
+            net_t network{init_v};
+            // Step the network every simulated second, recording the last disagreement after every switch.
+            times_t* hop_last = &hop_conv[(d * seed_num + seed) * source_num];
+            times_t* stable_last = &stable_conv[(d * seed_num + seed) * source_num];
+            for (size_t t = 1; t <= end_time; ++t) {
+                run_until(network, t);
+                size_t s = std::min<size_t>(t / conv_time, source_num - 1);
+                if (not agreement<hop_diam>(network, node_num)) hop_last[s] = t - s * conv_time;
+                if (not agreement<stable_diam>(network, node_num)) stable_last[s] = t - s * conv_time;
+            }
+            // Run the simulation until exit.
+            network.run();
+        }
+    // Print mean and maximum convergence times over seeds, after every switch.
+    auto print = [](std::string name, std::vector<times_t> const& conv){
+        for (size_t d = 0; d < std::size(degrees); ++d) {
+            std::cout << name << " (degree " << (degrees[d] ? std::to_string(degrees[d]) : "unbounded") << "):";
+            for (size_t s = 0; s < source_num; ++s) {
+                times_t sum = 0, max = 0;
+                for (size_t seed = 0; seed < seed_num; ++seed) {
+                    times_t c = conv[(d * seed_num + seed) * source_num + s];
+                    sum += c;
+                    max = std::max(max, c);
+                }
+                std::cout << " source " << s << " mean " << sum / seed_num << " max " << max << (s + 1 < source_num ? ";" : "\n");
+            }
+        }
+    };
+    std::cout << "convergence times after the switch to every source (in simulated seconds):\n";
+    print("hop_diameter", hop_conv);
+    print("stable_diameter", stable_conv);
+    // Build plots.
+    std::cout << "*/\n";
+    std::cout << plot::file("bounded", p.build());
+    return 0;
+}
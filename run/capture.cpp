@@ -0,0 +1,84 @@
+// Copyright © 2025 Giorgio Audrito. All Rights Reserved.
+
+/**
+ * @file capture.cpp
+ * @brief Headless capture of frames of the case study, for videos and visual regression.
+ */
+
+#include <cstdlib>
+#include <string>
+
+#include "lib/capture.hpp"
+#include "lib/case_study.hpp"
+
+/**
+ * @brief Namespace containing all the objects in the FCPP library.
+ */
+namespace fcpp {
+
+//! @brief Default simulated time between frames.
+constexpr times_t default_frame_step = 0.5;
+//! @brief Width (and height) of frames in pixels.
+constexpr size_t frame_width = 800;
+
+//! @brief Collects the nodes of a network into a frame.
+template <typename net_t>
+frame snapshot(net_t& network, times_t t) {
+    using namespace coordination::tags;
+    frame f{t, {}};
+    for (device_t uid = 0; uid < node_num; ++uid)
+        if (network.node_count(uid)) {
+            auto& n = network.node_at(uid);
+            vec<dim> const& p = n.position();
+            f.dots.push_back({p[0], p[1], n.storage(node_size{}) / 2, to_pixel(n.storage(node_color_in{})), to_pixel(n.storage(node_color_out{}))});
+        }
+    return f;
+}
+
+} // namespace fcpp
+
+
+//! @brief The main function.
+int main(int argc, char** argv) {
+    using namespace fcpp;
+
+    // The simulated time between frames, optionally given as `frame_step=t` (or `--frame_step=t`).
+    times_t frame_step = default_frame_step;
+    if (argc > 1) {
+        std::string a = argv[1];
+        if (a.compare(0, 2, "--") == 0) a = a.substr(2);
+        bool named = a.compare(0, 11, "frame_step=") == 0 and a.size() > 11;
+        char* e;
+        if (named) frame_step = std::strtod(a.c_str() + 11, &e);
+        if (argc > 2 or not named or *e or not (frame_step > 0 and frame_step < INF)) {
+            std::cerr << argv[0] << ": frame_step must be a positive number, found: " << argv[1] << "\n";
+            std::cerr << "usage: " << argv[0] << " [frame_step=t]\n";
+            return 1;
+        }
+    }
+    // The plotter object.
+    option::plot_t p;
+    std::cout << "/*\n";
+    {
+        // The network object type (batch simulator with given options).
+        using net_t = component::batch_simulator<option::list>::net;
+        // The initialisation values (simulation name, plotter object and no degree bound, fixed rounds).
+        auto init_v = common::make_tagged_tuple<option::name, option::plotter, option::degree, option::adaptive>("Frame capture", &p, 0, false);
+        // Construct the network object.
+        net_t network{init_v};
+        // The background frame writer.
+        frame_writer writer("output/frames/frame-", frame_width, size);
+        // Run the simulation, capturing a frame every frame_step simulated seconds
+        // (after the events at the time of the frame, so that the first one shows the nodes spawned at time zero).
+        for (size_t i = 0; i * frame_step <= end_time; ++i) {
+            times_t t = i * frame_step;
+            while (network.next() <= t) network.update();
+            writer.push(snapshot(network, t));
+        }
+        network.run();
+    }
+    // Build plots.
+    std::cout << "*/\n";
+    std::cout << plot::file("capture", p.build());
+    return 0;
+}
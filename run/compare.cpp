@@ -0,0 +1,137 @@
+// Copyright © 2025 Giorgio Audrito. All Rights Reserved.
+
+/**
+ * @file compare.cpp
+ * @brief Comparison of benchmark results against a stored baseline.
+ *
+ * Usage: `compare <baseline.json> <current.json> [threshold] [alpha]`. For every configuration and measure
+ * (ns_per_round_node, bytes_per_message, convergence_time), repetitions are compared with a one-sided
+ * Mann-Whitney U test: a regression is reported when the median grows by more than `threshold` (relative,
+ * default 0.05) and the increase is significant at level `alpha` (default 0.05). Exits with 1 on regressions,
+ * on configurations or measures of the baseline missing from the current results, or if nothing was compared.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+//! @brief Names of the measures compared.
+constexpr char const* measures[] = {"ns_per_round_node", "bytes_per_message", "convergence_time"};
+
+//! @brief Values of every measure (by name) in every configuration (by function, topology and nodes).
+using results = std::map<std::string, std::map<std::string, std::vector<double>>>;
+
+//! @brief Reads the value of a key in a flat JSON object (as a raw string).
+std::string field(std::string const& line, std::string const& key) {
+    size_t i = line.find("\"" + key + "\":");
+    if (i == std::string::npos) return "";
+    i = line.find_first_not_of(" ", i + key.size() + 3);
+    if (line[i] == '"') return line.substr(i + 1, line.find('"', i + 1) - i - 1);
+    return line.substr(i, line.find_first_of(",}", i) - i);
+}
+
+//! @brief Reads benchmark results from a file with a JSON object per line.
+results read(std::string const& file) {
+    std::ifstream is(file);
+    if (not is) {
+        std::cerr << "cannot read " << file << std::endl;
+        std::exit(2);
+    }
+    results r;
+    for (std::string line; std::getline(is, line);) {
+        if (line.find('{') == std::string::npos) continue;
+        std::string config = field(line, "function") + " " + field(line, "topology") + " " + field(line, "nodes");
+        for (char const* m : measures) {
+            std::string v = field(line, m);
+            if (v.size()) r[config][m].push_back(std::stod(v));
+        }
+    }
+    return r;
+}
+
+//! @brief Median of a sequence of values.
+double median(std::vector<double> v) {
+    std::sort(v.begin(), v.end());
+    size_t n = v.size();
+    return n == 0 ? NAN : n % 2 ? v[n/2] : (v[n/2-1] + v[n/2]) / 2;
+}
+
+//! @brief Mann-Whitney U statistic of `y` over `x` (counting ties as 1/2).
+double u_statistic(std::vector<double> const& x, std::vector<double> const& y) {
+    double u = 0;
+    for (double a : x)
+        for (double b : y)
+            u += b > a ? 1 : b == a ? 0.5 : 0;
+    return u;
+}
+
+//! @brief P-value of the one-sided Mann-Whitney test that `y` is stochastically greater than `x`.
+double mann_whitney(std::vector<double> const& x, std::vector<double> const& y) {
+    size_t n1 = x.size(), n2 = y.size(), n = n1 + n2;
+    double u = u_statistic(x, y);
+    if (n <= 20) {
+        // exact distribution, by enumerating all splits of the pooled sample
+        std::vector<double> all(x);
+        all.insert(all.end(), y.begin(), y.end());
+        std::vector<bool> pick(n, false);
+        std::fill(pick.begin() + n1, pick.end(), true);
+        size_t tot = 0, hits = 0;
+        do {
+            std::vector<double> a, b;
+            for (size_t i = 0; i < n; ++i) (pick[i] ? b : a).push_back(all[i]);
+            hits += u_statistic(a, b) >= u - 1e-9;
+            ++tot;
+        } while (std::next_permutation(pick.begin(), pick.end()));
+        return hits / double(tot);
+    }
+    // normal approximation, with continuity correction
+    double mu = n1 * n2 / 2.0, sigma = std::sqrt(n1 * n2 * (n + 1) / 12.0);
+    return 0.5 * std::erfc((u - mu - 0.5) / sigma / std::sqrt(2.0));
+}
+
+//! @brief The main function.
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        std::cerr << "usage: " << argv[0] << " <baseline.json> <current.json> [threshold] [alpha]" << std::endl;
+        return 2;
+    }
+    results base = read(argv[1]), curr = read(argv[2]);
+    double threshold = argc > 3 ? std::stod(argv[3]) : 0.05;
+    double alpha = argc > 4 ? std::stod(argv[4]) : 0.05;
+    size_t regressions = 0, compared = 0, missing = 0;
+    std::cout << std::setprecision(4);
+    for (auto const& c : base) {
+        if (curr.count(c.first) == 0) {
+            ++missing;
+            std::cout << "MISSING " << c.first << "\n";
+            continue;
+        }
+        for (auto const& m : c.second) {
+            auto const& a = curr.at(c.first);
+            if (a.count(m.first) == 0) {
+                ++missing;
+                std::cout << "MISSING " << c.first << " " << m.first << "\n";
+                continue;
+            }
+            std::vector<double> const& x = m.second;
+            std::vector<double> const& y = a.at(m.first);
+            double mx = median(x), my = median(y);
+            double change = mx == 0 ? (my == 0 ? 0 : INFINITY) : my / mx - 1;
+            double p = mann_whitney(x, y);
+            ++compared;
+            if (change > threshold and p < alpha) {
+                ++regressions;
+                std::cout << "REGRESSION " << c.first << " " << m.first << ": " << mx << " -> " << my
+                          << " (+" << change * 100 << "%, p = " << p << ")\n";
+            }
+        }
+    }
+    std::cout << compared << " measures compared, " << missing << " missing, " << regressions << " regressions (threshold +" << threshold * 100 << "%, alpha " << alpha << ")" << std::endl;
+    return regressions > 0 or missing > 0 or compared == 0;
+}
@@ -0,0 +1,103 @@
+// Copyright © 2025 Giorgio Audrito. All Rights Reserved.
+
+/**
+ * @file montecarlo.cpp
+ * @brief Monte Carlo estimation of the convergence time of hop_diameter after the last source switch.
+ */
+
+#include <algorithm>
+#include <thread>
+
+//! @brief Nothing is rendered in this executable.
+#define FCPP_CASE_STUDY_RENDER 0
+//! @brief Rounds are sequential, since the network is forked.
+#define FCPP_CASE_STUDY_PARALLEL 0
+
+#include "lib/case_study.hpp"
+#include "lib/checkpoint.hpp"
+
+/**
+ * @brief Namespace containing all the objects in the FCPP library.
+ */
+namespace fcpp {
+
+//! @brief Time of the last source switch.
+constexpr times_t switch_time = (source_num - 1) * conv_time;
+//! @brief Time of the checkpoint shared by all runs (shortly before the last source switch).
+constexpr times_t warm_time = switch_time - 10;
+//! @brief Number of runs forked from the checkpoint.
+constexpr size_t run_num = 1000;
+
+//! @brief Outcome of a run.
+struct run_result {
+    //! @brief Time after the switch of the last disagreement.
+    times_t conv;
+    //! @brief Whether nodes still disagreed at the end time (so that the convergence time is only a lower bound).
+    bool censored;
+};
+
+//! @brief Reseeds the random generators of a network and its nodes.
+template <typename net_t>
+void reseed(net_t& network, size_t seed) {
+    network.generator().seed(seed);
+    for (device_t uid = 0; uid < node_num; ++uid)
+        if (network.node_count(uid))
+            network.node_at(uid).generator().seed(seed * node_num + uid);
+}
+
+} // namespace fcpp
+
+
+//! @brief The main function.
+int main() {
+    using namespace fcpp;
+
+    // The plotter object (unused, logs are discarded).
+    option::plot_t p;
+    std::ostream null_stream(nullptr);
+    // The network object type (batch simulator with given options).
+    using net_t = component::batch_simulator<option::list>::net;
+    // The initialisation values (simulation name, log stream, plotter object and no degree bound, fixed rounds).
+    auto init_v = common::make_tagged_tuple<option::name, option::output, option::plotter, option::degree, option::adaptive>("Monte Carlo", &null_stream, &p, 0, false);
+    // Construct the network object.
+    net_t network{init_v};
+    // Run the common prefix of the simulations only once.
+    run_until(network, warm_time);
+    // Fork the runs, each measuring the time after the switch of the last disagreement.
+    std::vector<run_result> runs;
+    size_t failed = fork_map<run_result>(run_num, std::thread::hardware_concurrency(), [&](size_t i){
+        reseed(network, i+1);
+        times_t last = switch_time;
+        bool agree = true;
+        for (times_t t = warm_time + 1; t <= end_time; ++t) {
+            run_until(network, t);
+            agree = agreement<coordination::tags::hop_diam>(network, node_num);
+            // disagreements before the switch are about the previous source
+            if (t >= switch_time and not agree) last = t;
+        }
+        return run_result{last - switch_time, not agree};
+    }, [&](size_t, run_result r){
+        runs.push_back(r);
+    });
+    // Print the empirical distribution of convergence times (censored runs marked as lower bounds).
+    std::sort(runs.begin(), runs.end(), [](run_result const& a, run_result const& b){
+        return a.conv < b.conv or (a.conv == b.conv and a.censored < b.censored);
+    });
+    size_t censored = std::count_if(runs.begin(), runs.end(), [](run_result const& r){
+        return r.censored;
+    });
+    std::cout << "runs: " << runs.size() << "\n";
+    std::cout << "failed: " << failed << "\n";
+    std::cout << "censored: " << censored << "\n";
+    if (runs.empty()) return 1;
+    auto print = [](run_result const& r){
+        std::cout << ": " << (r.censored ? ">= " : "") << r.conv << "\n";
+    };
+    for (real_t q : {0.5, 0.9, 0.99, 0.999}) {
+        std::cout << "quantile " << q;
+        print(runs[std::min<size_t>(q * runs.size(), runs.size() - 1)]);
+    }
+    std::cout << "max";
+    print(runs.back());
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,184 @@
+// Copyright © 2025 Giorgio Audrito. All Rights Reserved.
+
+/**
+ * @file precision.cpp
+ * @brief Error against bandwidth of stable_diameter with reduced-precision exports.
+ *
+ * Every seed is run once with real_t exports (the baseline) and once with every reduced-precision
+ * type, on the same network and round schedule. Prints one JSON object per line and run, with the
+ * bytes per message and the error of stable_diam against the baseline at the same node and time.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include "lib/examples.hpp"
+
+/**
+ * @brief Namespace containing all the objects in the FCPP library.
+ */
+namespace fcpp {
+
+//! @brief Number of nodes in the area.
+constexpr size_t node_num = 500;
+//! @brief Size of the area.
+constexpr size_t size = 1000;
+//! @brief The maximum communication range between nodes.
+constexpr size_t comm_range = 100;
+//! @brief Dimensionality of the space.
+constexpr size_t dim = 2;
+//! @brief End of every simulation.
+constexpr size_t end_time = 100;
+//! @brief Number of seeds.
+constexpr size_t seeds = 10;
+
+//! @brief Names of the export types compared (the first being the baseline).
+constexpr char const* types[] = {"real_t", "float", "fixed<int32_t,256>"};
+
+
+//! @brief Namespace containing the libraries of coordination routines.
+namespace coordination {
+
+//! @brief Tags used in the node storage.
+namespace tags {
+    //! @brief Index of the export type.
+    struct type_id {};
+    //! @brief Value computed for the stabilised real diameter.
+    struct stable_diam {};
+    //! @brief Number of rounds performed.
+    struct rounds {};
+    //! @brief Total size of messages sent.
+    struct bytes {};
+}
+
+//! @brief Main function.
+MAIN() {
+    // import tag names in the local scope.
+    using namespace tags;
+
+    // run stable_diameter with the chosen export type
+    bool source = node.uid == 0;
+    diam_data r;
+    switch (node.storage(type_id{})) {
+        case 0:  r = stable_diameter<real_t>(CALL, source); break;
+        case 1:  r = stable_diameter<float>(CALL, source); break;
+        default: r = stable_diameter<fixed<int32_t, 256>>(CALL, source); break;
+    }
+
+    // record measures
+    node.storage(stable_diam{}) = get<2>(r);
+    node.storage(rounds{}) += 1;
+    node.storage(bytes{}) += node.msg_size();
+}
+//! @brief Export types used by the main function (update it when expanding the program).
+FUN_EXPORT main_t = export_list<real_t, float, fixed<int32_t, 256>>;
+
+} // namespace coordination
+
+
+// SYSTEM SETUP
+
+//! @brief Namespace for component options.
+namespace option {
+
+//! @brief Import tags to be used for component options.
+using namespace component::tags;
+//! @brief Import tags used by aggregate functions.
+using namespace coordination::tags;
+
+//! @brief Description of the round schedule.
+using round_s = sequence::periodic<
+    distribution::interval_n<times_t, 0, 1>,      // uniform time in the [0,1] interval for start
+    distribution::weibull_n<times_t, 10, 1, 10>,  // weibull-distributed time for interval (10/10=1 mean, 1/10=0.1 deviation)
+    distribution::constant_n<times_t, end_time>   // the constant end_time number for end
+>;
+//! @brief The sequence of node generation events (node_num devices all generated at time 0).
+using spawn_s = sequence::multiple_n<node_num, 0>;
+//! @brief The distribution of initial node positions (random in a square).
+using rectangle_d = distribution::rect_n<1, 0, 0, size, size>;
+//! @brief The contents of the node storage as tags and associated types.
+using store_t = tuple_store<
+    type_id,                    size_t,
+    stable_diam,                real_t,
+    rounds,                     size_t,
+    bytes,                      size_t,
+    debug,                      std::string
+>;
+
+//! @brief The general simulation options.
+DECLARE_OPTIONS(list,
+    parallel<false>,     // single-threaded, so that runs with the same seed are paired
+    synchronised<false>, // optimise for asynchronous networks
+    program<coordination::main>,   // program to be run (refers to MAIN above)
+    exports<coordination::main_t>, // export type list (types used in messages)
+    retain<metric::retain<3,1>>,   // messages are kept for 3 seconds before expiring
+    message_size<true>,      // the size of messages is computed
+    round_schedule<round_s>, // the sequence generator for round events on nodes
+    spawn_schedule<spawn_s>, // the sequence generator of node creation events on the network
+    store_t,       // the contents of the node storage
+    init<
+        x,       rectangle_d, // initialise position randomly in a rectangle for new nodes
+        type_id, distribution::constant_i<size_t, type_id> // the export type is read from the network parameters
+    >,
+    dimension<dim>, // dimensionality of the space
+    connector<connect::fixed<comm_range, 1, dim>> // connection allowed within a fixed comm range
+);
+
+} // namespace option
+
+} // namespace fcpp
+
+
+//! @brief The main function.
+int main() {
+    using namespace fcpp;
+    using namespace coordination::tags;
+
+    // The network object type (batch simulator with given options).
+    using net_t = component::batch_simulator<option::list>::net;
+    // The stream where logs are discarded.
+    std::ostream null_stream(nullptr);
+    for (size_t seed = 0; seed < seeds; ++seed) {
+        // The baseline values of every node at every simulated second.
+        std::vector<std::vector<real_t>> baseline(end_time, std::vector<real_t>(node_num, INF));
+        for (size_t t = 0; t < std::size(types); ++t) {
+            // The initialisation values (simulation name, log stream, seed and export type).
+            auto init_v = common::make_tagged_tuple<option::name, option::output, option::seed, type_id>("Precision", &null_stream, seed, t);
+            // Construct the network object.
+            net_t network{init_v};
+            // Run the simulation, comparing values with the baseline at every simulated second.
+            real_t err_sum = 0, err_max = 0, rel_sum = 0;
+            size_t err_num = 0;
+            for (size_t s = 0; s < end_time; ++s) {
+                while (network.next() <= s + 1) network.update();
+                for (device_t uid = 0; uid < node_num; ++uid) {
+                    real_t v = network.node_at(uid).storage(stable_diam{});
+                    if (t == 0) baseline[s][uid] = v;
+                    real_t b = baseline[s][uid];
+                    if (std::isinf(b) or b == 0) continue;
+                    real_t e = std::abs(v - b);
+                    err_sum += e;
+                    err_max = std::max(err_max, e);
+                    rel_sum += e / b;
+                    ++err_num;
+                }
+            }
+            network.run();
+            // Collect the results.
+            size_t rounds_sum = 0, bytes_sum = 0;
+            for (device_t uid = 0; uid < node_num; ++uid) {
+                auto& d = network.node_at(uid);
+                rounds_sum += d.storage(rounds{});
+                bytes_sum += d.storage(bytes{});
+            }
+            std::cout << "{\"type\": \"" << types[t] << "\", \"seed\": " << seed
+                      << ", \"bytes_per_message\": " << bytes_sum / real_t(rounds_sum)
+                      << ", \"mean_abs_error\": " << err_sum / std::max<size_t>(err_num, 1)
+                      << ", \"max_abs_error\": " << err_max
+                      << ", \"mean_rel_error\": " << rel_sum / std::max<size_t>(err_num, 1) << "}" << std::endl;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,56 @@
+// Copyright © 2025 Giorgio Audrito. All Rights Reserved.
+
+/**
+ * @file scenario.cpp
+ * @brief Runs the case study in a scenario given on the command line, without recompiling.
+ *
+ * For example: `scenario node_num=2000 size=2000 conv_time=100` or `scenario config=scenario.txt`
+ * (see read_parameters in lib/case_study.hpp for the parameters and their format).
+ */
+
+#include <exception>
+#include <iostream>
+#include <string>
+
+//! @brief Nothing is rendered in this executable.
+#define FCPP_CASE_STUDY_RENDER 0
+//! @brief The scenario is read at run time.
+#define FCPP_CASE_STUDY_RUNTIME 1
+
+#include "lib/case_study.hpp"
+
+
+//! @brief The main function.
+int main(int argc, char** argv) {
+    using namespace fcpp;
+    using namespace coordination::tags;
+
+    // The parameters of the scenario.
+    parameters sc;
+    try {
+        sc = read_parameters(argc, argv);
+    } catch (std::exception const& e) {
+        std::cerr << argv[0] << ": " << e.what() << "\n";
+        std::cerr << "usage: " << argv[0] << " [config=file] [node_num=n] [size=s] [comm_range=r] [source_num=n] [conv_time=t] [end_time=t] [discard_time=t] [source_pos=x,y;x,y;...]\n";
+        return 1;
+    }
+    // The plotter object.
+    option::plot_t p;
+    std::cout << "/*\n";
+    {
+        // The network object type (batch simulator with given options).
+        using net_t = component::batch_simulator<option::list>::net;
+        // The initialisation values (simulation name, output file, plotter object, no degree bound, fixed rounds and scenario).
+        auto init_v = common::make_tagged_tuple<option::name, option::output, option::plotter, degree, adaptive, scenario, spawn_count, round_end, log_end, area_side, comm_radius>(
+            "Scenario", std::string("output/scenario.txt"), &p, 0, false, &sc, sc.node_num, sc.end_time + 2, sc.end_time, sc.size, sc.comm_range
+        );
+        // Construct the network object.
+        net_t network{init_v};
+        // Run the simulation until exit.
+        network.run();
+    }
+    // Build plots.
+    std::cout << "*/\n";
+    std::cout << plot::file("scenario", p.build());
+    return 0;
+}
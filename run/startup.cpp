@@ -0,0 +1,200 @@
+// Copyright © 2025 Giorgio Audrito. All Rights Reserved.
+
+/**
+ * @file startup.cpp
+ * @brief Measures the time to first round of large networks, with and without heap preallocation.
+ *
+ * Every configuration runs in a fresh forked process, printing one JSON object per line with the
+ * time to construct the network, to spawn all nodes and to complete the first round of every node.
+ * Only measurements are provided: nodes are allocated and spawned by FCPP, one at a time.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include <sys/resource.h>
+#include <unistd.h>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+#include "lib/checkpoint.hpp"
+#include "lib/examples.hpp"
+#include "lib/runtime.hpp"
+
+/**
+ * @brief Namespace containing all the objects in the FCPP library.
+ */
+namespace fcpp {
+
+//! @brief The maximum communication range between nodes.
+constexpr size_t comm_range = 100;
+//! @brief Expected number of neighbours.
+constexpr real_t density = 10;
+//! @brief Dimensionality of the space.
+constexpr size_t dim = 2;
+//! @brief Time after which old values are discarded.
+constexpr times_t discard_time = 10;
+//! @brief Numbers of nodes.
+constexpr size_t sizes[] = {10000, 100000, 1000000};
+//! @brief Bytes of heap faulted in per node, when preallocating.
+constexpr size_t node_reserve = 4096;
+
+
+//! @brief Namespace containing the libraries of coordination routines.
+namespace coordination {
+
+//! @brief Tags used in the node storage.
+namespace tags {
+    //! @brief Number of nodes in the network.
+    struct node_count {};
+    //! @brief Side of the area where nodes are placed.
+    struct area_side {};
+}
+
+//! @brief Main function.
+MAIN() {
+    // import tag names in the local scope.
+    using namespace tags;
+
+    hop_diameter(CALL, discard_time);
+    stable_diameter(CALL, node.uid == 0);
+}
+//! @brief Export types used by the main function (update it when expanding the program).
+FUN_EXPORT main_t = export_list<hop_diameter_t, stable_diameter_t>;
+
+} // namespace coordination
+
+
+// SYSTEM SETUP
+
+//! @brief Namespace for component options.
+namespace option {
+
+//! @brief Import tags to be used for component options.
+using namespace component::tags;
+//! @brief Import tags used by aggregate functions.
+using namespace coordination::tags;
+
+//! @brief Description of the round schedule (a single round per node).
+using round_s = sequence::periodic<
+    distribution::interval_n<times_t, 0, 1>, // uniform time in the [0,1] interval for start
+    distribution::constant_n<times_t, 2>,    // the constant 2 for interval
+    distribution::constant_n<times_t, 1>     // the constant 1 for end
+>;
+//! @brief The sequence of node generation events (node_count devices all generated at time 0).
+using spawn_s = sequence::multiple<distribution::constant_i<size_t, node_count>, distribution::constant_n<times_t, 0>>;
+//! @brief The contents of the node storage as tags and associated types.
+using store_t = tuple_store<
+    node_count,                 size_t,
+    debug,                      std::string
+>;
+
+//! @brief The general simulation options.
+DECLARE_OPTIONS(list,
+    parallel<true>,      // multithreading enabled on node rounds
+    synchronised<false>, // optimise for asynchronous networks
+    program<coordination::main>,   // program to be run (refers to MAIN above)
+    exports<coordination::main_t>, // export type list (types used in messages)
+    round_schedule<round_s>, // the sequence generator for round events on nodes
+    spawn_schedule<spawn_s>, // the sequence generator of node creation events on the network
+    store_t,       // the contents of the node storage
+    init<
+        x,          distribution::cube_i<area_side, dim>,       // initialise position randomly in a square read from the network parameters
+        node_count, distribution::constant_i<size_t, node_count> // the number of nodes is read from the network parameters
+    >,
+    dimension<dim>, // dimensionality of the space
+    connector<connect::fixed<comm_range, 1, dim>> // connection allowed within a fixed comm range
+);
+
+} // namespace option
+
+
+//! @brief Times measured at startup (in seconds).
+struct startup_times {
+    //! @brief Time to construct the network.
+    double construct;
+    //! @brief Time to spawn all nodes.
+    double spawn;
+    //! @brief Time to complete the first round of every node.
+    double first_round;
+    //! @brief Peak resident memory (in KiB).
+    long peak_rss;
+};
+
+/**
+ * @brief Faults in heap memory in advance, so that nodes are allocated in pages already mapped.
+ *
+ * The memory is allocated in blocks below the mmap threshold (so that they come from the heap), every page is
+ * touched, and blocks are freed with trimming disabled, so that the memory stays in the heap for later allocations.
+ */
+inline void prefault_heap(size_t bytes) {
+#ifdef __GLIBC__
+    mallopt(M_TRIM_THRESHOLD, -1);
+    constexpr size_t block = 64 * 1024;
+    size_t page = sysconf(_SC_PAGESIZE);
+    std::vector<char*> blocks;
+    blocks.reserve(bytes / block + 1);
+    for (size_t b = 0; b < bytes; b += block) {
+        char* p = static_cast<char*>(malloc(block));
+        if (p == nullptr) break;
+        for (size_t i = 0; i < block; i += page) p[i] = 0;
+        blocks.push_back(p);
+    }
+    for (auto it = blocks.rbegin(); it != blocks.rend(); ++it) free(*it);
+#endif
+}
+
+//! @brief Measures the startup of a network of a given size.
+inline startup_times measure(size_t n) {
+    using namespace coordination::tags;
+    using clock = std::chrono::steady_clock;
+    // The network object type (batch simulator with given options).
+    using net_t = component::batch_simulator<option::list>::net;
+    // The stream where logs are discarded.
+    std::ostream null_stream(nullptr);
+    startup_times r;
+    auto start = clock::now();
+    // The side of the area where nodes are placed, keeping the density constant.
+    real_t side = comm_range * std::sqrt(n * M_PI / density);
+    // Construct the network object.
+    net_t network{common::make_tagged_tuple<option::name, option::output, node_count, area_side>("Startup", &null_stream, n, side)};
+    auto constructed = clock::now();
+    // Spawn all nodes (every first round happens after time zero).
+    while (network.next() <= 0) network.update();
+    auto spawned = clock::now();
+    // Run the first round of every node.
+    network.run();
+    auto end = clock::now();
+    r.construct = std::chrono::duration<double>(constructed - start).count();
+    r.spawn = std::chrono::duration<double>(spawned - constructed).count();
+    r.first_round = std::chrono::duration<double>(end - spawned).count();
+    rusage u;
+    getrusage(RUSAGE_SELF, &u);
+    r.peak_rss = u.ru_maxrss;
+    return r;
+}
+
+} // namespace fcpp
+
+
+//! @brief The main function.
+int main() {
+    using namespace fcpp;
+
+    // Every size, without and with heap preallocation, each in a fresh process.
+    size_t failed = fork_map<startup_times>(2 * std::size(sizes), 1, [](size_t i){
+        size_t n = sizes[i / 2];
+        if (i % 2) prefault_heap(n * node_reserve);
+        return measure(n);
+    }, [](size_t i, startup_times r){
+        std::cout << "{\"nodes\": " << sizes[i / 2] << ", \"preallocated\": " << (i % 2 ? "true" : "false")
+                  << ", \"construct_s\": " << r.construct << ", \"spawn_s\": " << r.spawn << ", \"first_round_s\": " << r.first_round
+                  << ", \"time_to_first_round_s\": " << r.construct + r.spawn + r.first_round << ", \"peak_rss_kib\": " << r.peak_rss << "}" << std::endl;
+    });
+    if (failed) std::cerr << failed << " of " << 2 * std::size(sizes) << " configurations failed\n";
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,64 @@
+// Copyright © 2025 Giorgio Audrito. All Rights Reserved.
+
+/**
+ * @file warmstart.cpp
+ * @brief What-if runs of the case study forked from a single warm state.
+ *
+ * The common prefix runs the bounded functions with a bound of node_num (bounding nothing),
+ * so that every branch continues from the same warm aggregate state with its own degree bound.
+ */
+
+//! @brief Nothing is rendered in this executable.
+#define FCPP_CASE_STUDY_RENDER 0
+//! @brief Rounds are sequential, since the network is forked.
+#define FCPP_CASE_STUDY_PARALLEL 0
+
+#include "lib/case_study.hpp"
+#include "lib/checkpoint.hpp"
+
+/**
+ * @brief Namespace containing all the objects in the FCPP library.
+ */
+namespace fcpp {
+
+//! @brief Time of the checkpoint (shortly before the 4th source switch).
+constexpr times_t warm_time = 3 * conv_time - 10;
+
+//! @brief Degree bounds to be tried after the checkpoint (node_num bounding nothing).
+constexpr size_t what_if[] = {node_num, 4, 8, 16};
+
+} // namespace fcpp
+
+
+//! @brief The main function.
+int main() {
+    using namespace fcpp;
+
+    // The plotter object.
+    option::plot_t p;
+    // The network object type (batch simulator with given options).
+    using net_t = component::batch_simulator<option::list>::net;
+    // The initialisation values (simulation name, plotter object and a degree bound of node_num, fixed rounds).
+    auto init_v = common::make_tagged_tuple<option::name, option::plotter, option::degree, option::adaptive>("Warm start", &p, what_if[0], false);
+    // Construct the network object.
+    net_t network{init_v};
+    // Run the common prefix of the simulations only once.
+    run_until(network, warm_time);
+    // Fork one branch per what-if scenario, each logging to its own file.
+    size_t failed;
+    int b = branch(std::size(what_if), "output/warmstart", failed);
+    if (b < 0) {
+        if (failed) std::cerr << failed << " of " << std::size(what_if) << " branches failed\n";
+        return failed ? 1 : 0;
+    }
+    std::cout << "/*\n";
+    for (device_t uid = 0; uid < node_num; ++uid)
+        if (network.node_count(uid))
+            network.node_at(uid).storage(option::degree{}) = what_if[b];
+    // Run the branch until exit.
+    network.run();
+    // Build plots.
+    std::cout << "*/\n";
+    std::cout << plot::file("warmstart-" + std::to_string(b), p.build());
+    return 0;
+}